@@ -0,0 +1,33 @@
+#include "../Checks.hpp"
+#include "../Config.hpp"
+using namespace std;
+
+namespace flint {
+
+/**
+ * Check for blacklisted identifiers
+ *
+ * Only the identifiers with a symbol can be blacklisted, so only those are
+ * looked up, however long the blacklist.
+ *
+ * @param errors
+ *        Struct to track how many errors/warnings/advice occured
+ * @param path
+ *        The path to the file currently being linted
+ * @param tokens
+ *        The token list for the file
+ */
+void checkBlacklistedIdentifiers(ErrorFile&       errors,
+                                 const string&    path,
+                                 const TokenList& tokens,
+                                 const ScopeTree& scopes) {
+  if ((tokens.seenSymbols() & Config.bannedSymbolBits()) == 0) return;
+
+  for (const TokenList::SymbolAt& found: tokens.symbolsAt()) {
+    const BannedIdentifier* banned = Config.bannedIdentifier(found.symbol);
+    if (banned) lint(errors, tokens[found.token], banned->level, banned->message);
+  }
+};
+
+const CheckTraits traitsBlacklistedIdentifiers{Lint::ERROR, false, ALL_FILE_CATEGORIES};
+}  // namespace flint
@@ -0,0 +1,45 @@
+#include "../Checks.hpp"
+#include "../Config.hpp"
+using namespace std;
+
+namespace flint {
+
+/**
+ * Check for blacklisted sequences of tokens
+ *
+ * @param errors
+ *        Struct to track how many errors/warnings/advice occured
+ * @param path
+ *        The path to the file currently being linted
+ * @param tokens
+ *        The token list for the file
+ */
+void checkBlacklistedSequences(ErrorFile&       errors,
+                               const string&    path,
+                               const TokenList& tokens,
+                               const ScopeTree& scopes) {
+  const SequenceMatcher&        matcher   = Config.sequenceMatcher();
+  const vector<BannedSequence>& blacklist = Config.bannedSequences();
+
+  // The tokens of the last exception found; being longer, it is reported
+  // before the blacklisted sequence it ends with
+  size_t exceptionBegin = 0;
+  size_t exceptionEnd   = 0;
+  matcher.scan(tokens, 0, tokens.size(), [&](size_t sequence, size_t pos) -> size_t {
+    if (sequence >= blacklist.size()) {
+      exceptionBegin = pos;
+      exceptionEnd   = pos + matcher.length(sequence);
+      return pos + 1;
+    }
+
+    // Make sure we aren't at an exception to the blacklist
+    if (pos >= exceptionBegin && pos + matcher.length(sequence) <= exceptionEnd) return pos + 1;
+
+    const BannedSequence& entry = blacklist[sequence];
+    if (!(Options.CMODE && entry.cppOnly)) lintWarning(errors, tokens[pos], entry.title, entry.description);
+    return pos + 1;
+  });
+};
+
+const CheckTraits traitsBlacklistedSequences{Lint::WARNING, false, ALL_FILE_CATEGORIES};
+}  // namespace flint
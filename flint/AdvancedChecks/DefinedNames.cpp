@@ -0,0 +1,66 @@
+#include "../Checks.hpp"
+using namespace std;
+
+namespace flint {
+
+/**
+ * No #defined names use an identifier reserved to the
+ * implementation.
+ *
+ * These are enforcing rules that actually apply to all identifiers,
+ * but we're only raising warnings for #define'd ones right now.
+ *
+ * @param errors
+ *        Struct to track how many errors/warnings/advice occured
+ * @param path
+ *        The path to the file currently being linted
+ * @param tokens
+ *        The token list for the file
+ */
+void checkDefinedNames(ErrorFile& errors, const string& path, const TokenList& tokens, const ScopeTree& scopes) {
+  // Exceptions to the check
+  static const array<string, 4> okNames{
+      {"__STDC_LIMIT_MACROS", "__STDC_FORMAT_MACROS", "_GNU_SOURCE", "_XOPEN_SOURCE"}};
+  const auto isOk = [](const StringFragment& sym) {
+    return any_of(begin(okNames), end(okNames), [&](const string& name) { return sym == StringFragment(name); });
+  };
+
+  for (const Directive& directive: tokens.directives()) {
+    if (directive.kind_ != TK_DEFINE) continue;
+
+    // Only copy the symbol out of the file when there is something to report
+    const auto            tok = tokens[directive.token_ + 1];
+    const StringFragment& sym = tok.value_;
+
+    if (!isTok(tok, TK_IDENTIFIER)) {
+      // This actually happens because people #define private public
+      //   for unittest reasons
+      lintWarning(errors, tok, "You're not supposed to #define " + to_string(sym));
+      continue;
+    }
+
+    if (sym.size() >= 2 && sym[0] == '_' && isupper(sym[1])) {
+      if (isOk(sym)) continue;
+      lintWarning(errors,
+                  tok,
+                  "Symbol " + to_string(sym) + " invalid.",
+                  "A symbol may not start with an underscore followed by a capital letter.");
+    } else if (sym.size() >= 2 && sym[0] == '_' && sym[1] == '_') {
+      if (isOk(sym)) continue;
+      lintWarning(errors,
+                  tok,
+                  "Symbol " + to_string(sym) + " invalid.",
+                  "A symbol may not begin with two adjacent underscores.");
+    } else if (!Options.CMODE && search_n(sym.begin(), sym.end(), 2, '_') !=
+                                     sym.end()) {  // !FLAGS_c_mode /* C is less restrictive about this */ &&
+      if (isOk(sym)) continue;
+      lintWarning(errors,
+                  tok,
+                  "Symbol " + to_string(sym) + " invalid. ",
+                  "A symbol may not contain two adjacent underscores.");
+    }
+  }
+};
+
+const CheckTraits traitsDefinedNames{Lint::WARNING, false, ALL_FILE_CATEGORIES};
+}  // namespace flint
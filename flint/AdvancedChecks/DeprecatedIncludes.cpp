@@ -0,0 +1,31 @@
+#include "../Checks.hpp"
+#include "../Config.hpp"
+using namespace std;
+
+namespace flint {
+
+/**
+ * Ensures that no files contain deprecated includes.
+ *
+ * @param errors
+ *        Struct to track how many errors/warnings/advice occured
+ * @param path
+ *        The path to the file currently being linted
+ * @param tokens
+ *        The token list for the file
+ */
+void checkDeprecatedIncludes(ErrorFile& errors, const string& path, const TokenList& tokens, const ScopeTree& scopes) {
+  for (const Directive& directive: tokens.directives()) {
+    if (directive.kind_ != TK_INCLUDE) continue;
+
+    const size_t pos = directive.token_ + 1;
+    if (!isTok(tokens[pos], TK_STRING_LITERAL) || cmpTok(tokens[pos], "PRECOMPILED")) continue;
+
+    const StringFragment includedFile{tokens.includedPath(directive)};
+    if (Config.isDeprecatedInclude(includedFile))
+      lintWarning(errors, tokens[directive.token_], "Including deprecated header '" + to_string(includedFile) + "'");
+  }
+};
+
+const CheckTraits traitsDeprecatedIncludes{Lint::WARNING, false, ALL_FILE_CATEGORIES};
+}  // namespace flint
@@ -13,36 +13,28 @@ namespace flint {
  * @param tokens
  *        The token list for the file
  */
-void checkExceptionInheritance(ErrorFile&            errors,
-                               const string&         path,
-                               const vector<Token>&  tokens,
-                               const vector<size_t>& structures) {
-  static constexpr array<TokenType, 4> classMarkersWithColon{TK_EOF, TK_LCURL, TK_SEMICOLON, TK_COLON};
-
+void checkExceptionInheritance(ErrorFile&       errors,
+                               const string&    path,
+                               const TokenList& tokens,
+                               const ScopeTree& scopes) {
   static constexpr array<TokenType, 3> accessSpecifiers{TK_PUBLIC, TK_PRIVATE, TK_PROTECTED};
 
-  for (unsigned long structure: structures) {
-    // Start pos at the index of each identified structure
-    const auto  pos = begin(tokens) + structure;
-    const auto& tok = *pos;
-
-    if (isTok(tok, TK_UNION)) continue;
-
-    const auto colon = find_first_of(pos, end(tokens), begin(classMarkersWithColon), end(classMarkersWithColon), isTok);
+  for (const Scope& scope: scopes.scopes()) {
+    // Only classes and structs with a list of base classes
+    if (!(scope.kind_ == ScopeKind::STRUCT || scope.kind_ == ScopeKind::CLASS)) continue;
+    if (scope.bases_ == Scope::NO_TOKEN) continue;
 
-    if (colon == end(tokens)) return;
+    const auto colon      = begin(tokens) + scope.bases_;
+    const auto endOfClass = begin(tokens) + scope.open_;
 
-    if (colon->type_ != TK_COLON) continue;
-
-    const auto endOfClass   = getEndOfClass(colon + 1, end(tokens));
     const auto exceptionPos = find_if(colon + 1, endOfClass, [](const Token& candidate) {
-      return isTok(candidate, TK_IDENTIFIER) && cmpTok(candidate, "exception");
+      return candidate.symbol() == SYM_EXCEPTION;
     });
 
     if (exceptionPos == endOfClass) continue;
 
     const auto usingStdException = !isTok(*(exceptionPos - 1), TK_DOUBLE_COLON) ||
-                                   (isTok(*(exceptionPos - 2), TK_IDENTIFIER) && cmpTok(*(exceptionPos - 2), "std"));
+                                   (exceptionPos - 2)->symbol() == SYM_STD;
     if (!usingStdException) continue;
 
     // OK, we're going with the last access specifier before the exception token
@@ -54,8 +46,11 @@ void checkExceptionInheritance(ErrorFile&            errors,
           return access == end(accessSpecifiers) ? curr : *access;
         });
 
-    if ((isTok(tok, TK_CLASS) && lastAccess != TK_PUBLIC) || (isTok(tok, TK_STRUCT) && lastAccess == TK_PRIVATE))
+    if ((scope.kind_ == ScopeKind::CLASS && lastAccess != TK_PUBLIC) ||
+        (scope.kind_ == ScopeKind::STRUCT && lastAccess == TK_PRIVATE))
       lintWarning(errors, *exceptionPos, "std::exception should be inherited publically (C++ std: 11.2)");
   }
 };
+
+const CheckTraits traitsExceptionInheritance{Lint::WARNING, true, ALL_FILE_CATEGORIES};
 }  // namespace flint
@@ -0,0 +1,42 @@
+#include "../Checks.hpp"
+using namespace std;
+
+namespace flint {
+
+/**
+ * Balance of #if(#ifdef, #ifndef)/#endif.
+ *
+ * @param errors
+ *        Struct to track how many errors/warnings/advice occured
+ * @param path
+ *        The path to the file currently being linted
+ * @param tokens
+ *        The token list for the file
+ */
+void checkIfEndifBalance(ErrorFile& errors, const string& path, const TokenList& tokens, const ScopeTree& scopes) {
+  int openIf = 0;
+  for (const Directive& directive: tokens.directives()) {
+    const auto tok = tokens[directive.token_];
+    switch (directive.kind_) {
+      case TK_POUNDIF:
+      case TK_IFDEF:
+      case TK_IFNDEF: ++openIf; break;
+      case TK_ENDIF:
+        --openIf;
+        if (openIf < 0) lintError(errors, tok, "Unmatched #endif.");
+        break;
+      case TK_POUNDELSE:
+        if (openIf == 0) lintError(errors, tok, "Unmatched #else.");
+        break;
+      case TK_POUNDELIF:
+        if (openIf == 0) lintError(errors, tok, "Unmatched #elif.");
+        break;
+      default: break;
+    }
+  }
+
+  if (openIf != 0) lintError(errors, tokens.back(), "Unmatched #if/#endif.");
+};
+
+const CheckTraits traitsIfEndifBalance{Lint::ERROR, false, ALL_FILE_CATEGORIES};
+}  // namespace flint
@@ -1,4 +1,5 @@
 #include "../Checks.hpp"
+#include "../SequenceMatcher.hpp"
 using namespace std;
 
 namespace flint {
@@ -15,59 +16,48 @@ namespace flint {
  * @param tokens
  *        The token list for the file
  */
-void checkImplicitCast(ErrorFile&            errors,
-                       const string&         path,
-                       const vector<Token>&  tokens,
-                       const vector<size_t>& structures) {
-  if (getFileCategory(path) == FileCategory::SOURCE_C) return;
-
+void checkImplicitCast(ErrorFile&       errors,
+                       const string&    path,
+                       const TokenList& tokens,
+                       const ScopeTree& scopes) {
   static const string lintOverride{"/* implicit */"};
 
-  static constexpr array<TokenType, 3> explicitConstOperator{TK_EXPLICIT, TK_CONSTEXPR, TK_OPERATOR};
-  static constexpr array<TokenType, 2> explicitOperator{TK_EXPLICIT, TK_OPERATOR};
-  static constexpr array<TokenType, 2> doubleColonOperator{TK_DOUBLE_COLON, TK_OPERATOR};
-
   static constexpr array<TokenType, 4> boolOperator{TK_OPERATOR, TK_BOOL, TK_LPAREN, TK_RPAREN};
   static constexpr array<TokenType, 2> operatorDelete{TK_ASSIGN, TK_DELETE};
   static constexpr array<TokenType, 3> operatorConstDelete{TK_CONST, TK_ASSIGN, TK_DELETE};
 
+  // What the class bodies are scanned for
+  enum MemberSequence { BLOCK, EXPLICIT_CONST_OPERATOR, EXPLICIT_OPERATOR, DOUBLE_COLON_OPERATOR, OPERATOR };
+  static const SequenceMatcher members({
+      {TK_LCURL},
+      {TK_EXPLICIT, TK_CONSTEXPR, TK_OPERATOR},
+      {TK_EXPLICIT, TK_OPERATOR},
+      {TK_DOUBLE_COLON, TK_OPERATOR},
+      {TK_OPERATOR},
+  });
+
   // Check for constructor specifications inside classes
   const size_t toksize = tokens.size();
-  for (unsigned long pos: structures) {
-    if (!(isTok(tokens[pos], TK_STRUCT) || isTok(tokens[pos], TK_CLASS))) continue;
-
-    // Skip to opening '{'
-    for (; pos < toksize && !isTok(tokens[pos], TK_LCURL); ++pos)
-      if (!(pos < toksize) || isTok(tokens[pos], TK_SEMICOLON)) return;
-    ++pos;
-
-    for (; pos < toksize && !isTok(tokens[pos], TK_EOF); ++pos) {
-      const auto tok = tokens[pos];
-
-      // Any time we find an open curly skip straight to the closing one
-      if (isTok(tok, TK_LCURL)) {
-        pos = skipBlock(tokens, pos);
-        continue;
-      }
-
-      // If we actually find a closing one we know it's the object's closing bracket
-      if (isTok(tok, TK_RCURL)) break;
-
-      // Skip explicit functions
-      if (atSequence(tokens, pos, explicitConstOperator)) {
-        ++(++pos);
-        continue;
-      }
-      if (atSequence(tokens, pos, explicitOperator) || atSequence(tokens, pos, doubleColonOperator)) {
-        ++pos;
-        continue;
+  for (const Scope& scope: scopes.scopes()) {
+    if (!(scope.kind_ == ScopeKind::STRUCT || scope.kind_ == ScopeKind::CLASS)) continue;
+
+    members.scan(tokens, scope.open_ + 1, scope.close_, [&](size_t sequence, size_t pos) -> size_t {
+      switch (sequence) {
+        // Any time we find an open curly skip straight to the closing one
+        case BLOCK: return skipBlock(tokens, pos) + 1;
+        // Skip explicit functions; being longer, these come before the bare operator
+        case EXPLICIT_CONST_OPERATOR: return pos + 3;
+        case EXPLICIT_OPERATOR:
+        case DOUBLE_COLON_OPERATOR: return pos + 2;
+        default: break;
       }
+      const auto tok = tokens[pos];
 
       // bool Operator case
       if (atSequence(tokens, pos, boolOperator)) {
         if (atSequence(tokens, pos + 4, operatorDelete) || atSequence(tokens, pos + 4, operatorConstDelete)) {
           // Deleted implicit operators are ok.
-          continue;
+          return pos + 1;
         }
 
         lintError(errors,
@@ -78,12 +68,11 @@ void checkImplicitCast(ErrorFile&            errors,
                   "convenience is justified in this case, or consider defining a "
                   "function (see http://www.artima.com/cppsource/safebool.html for more "
                   "details).");
-        continue;
+        return pos + 1;
       }
 
       // Only want to process operators which do not have the overide
-      if (!isTok(tok, TK_OPERATOR) || contains(tok.precedingWhitespace_, lintOverride.cbegin(), lintOverride.cend()))
-        continue;
+      if (contains(tok.precedingWhitespace(), lintOverride)) return pos + 1;
 
       // Assume it is an implicit conversion unless proven otherwise
       bool   isImplicitConversion = false;
@@ -99,7 +88,7 @@ void checkImplicitCast(ErrorFile&            errors,
       }
 
       // The operator my not have been an implicit conversion
-      if (!isImplicitConversion) continue;
+      if (!isImplicitConversion) return pos + 1;
 
       lintWarning(errors,
                   tok,
@@ -107,7 +96,10 @@ void checkImplicitCast(ErrorFile&            errors,
                   "Prefix the function with the 'explicit' keyword to avoid this,"
                   " or add an /* implicit *"
                   "/ comment to suppress this warning.");
-    }
+      return pos + 1;
+    });
   }
 };
+
+const CheckTraits traitsImplicitCast{Lint::WARNING, true, ALL_FILE_CATEGORIES & ~categoryBit(SOURCE_C)};
 }  // namespace flint
@@ -15,41 +15,45 @@ namespace flint {
  * @param tokens
  *        The token list for the file
  */
-void checkIncludeAssociatedHeader(ErrorFile& errors, const string& path, const vector<Token>& tokens) {
-  if (!isSource(path)) return;
+void checkIncludeAssociatedHeader(ErrorFile&       errors,
+                                  const string&    path,
+                                  const TokenList& tokens,
+                                  const ScopeTree& scopes) {
+  static constexpr array<char, 2> separators{{'/', '\\'}};
 
   string file(path);
   size_t fpos = file.find_last_of("/\\");
   if (fpos != string::npos) file = file.substr(fpos + 1);
-  string fileBase = getFileNameBase(file);
+  const string fileBase = getFileNameBase(file);
 
   size_t includesFound = 0;
+  for (const Directive& directive: tokens.directives()) {
+    if (directive.kind_ != TK_INCLUDE) continue;
 
-  for (size_t pos = 0, size = tokens.size(); pos < size; ++pos) {
-    if (!isTok(tokens[pos], TK_INCLUDE)) continue;
-
-    ++pos;
-
+    const size_t pos = directive.token_ + 1;
     if (cmpTok(tokens[pos], "PRECOMPILED")) continue;
 
     ++includesFound;
 
     if (!isTok(tokens[pos], TK_STRING_LITERAL)) continue;
 
-    string       includedFile = getIncludedPath(tokens[pos].value_);
-    const size_t ipos         = includedFile.find_last_of("/\\");
-    if (ipos != string::npos) continue;
+    const StringFragment includedFile{tokens.includedPath(directive)};
+    if (find_first_of(includedFile.begin(), includedFile.end(), begin(separators), end(separators)) !=
+        includedFile.end())
+      continue;
 
-    if (cmpStr(getFileNameBase(includedFile), fileBase)) {
+    if (cmpStr(getFileNameBase(to_string(includedFile)), fileBase)) {
       if (includesFound > 1) {
         lintError(errors,
-                  tokens[pos - 1],
+                  tokens[directive.token_],
                   "The associated header file of .cpp "
                   "files should be included before any other includes.",
                   "This helps catch missing header file dependencies in the .h");
-        break;
+        return;
       }
     }
   }
 };
+
+const CheckTraits traitsIncludeAssociatedHeader{Lint::ERROR, false, categoryBit(SOURCE_C) | categoryBit(SOURCE_CPP)};
 }  // namespace flint
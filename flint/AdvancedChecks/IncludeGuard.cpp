@@ -13,13 +13,11 @@ namespace flint {
  * @param tokens
  *        The token list for the file
  */
-void checkIncludeGuard(ErrorFile& errors, const string& path, const vector<Token>& tokens) {
-  if (getFileCategory(path) != FileCategory::HEADER) return;
-
+void checkIncludeGuard(ErrorFile& errors, const string& path, const TokenList& tokens, const ScopeTree& scopes) {
   static constexpr array<TokenType, 2> pragmaOnce = {TK_PRAGMA, TK_IDENTIFIER};
 
   // Allow #pragma once as an include guard
-  if (atSequence(tokens, 0, pragmaOnce) && cmpTok(tokens[1], "once")) return;
+  if (atSequence(tokens, 0, pragmaOnce) && tokens.symbol(1) == SYM_ONCE) return;
 
   static constexpr array<TokenType, 4> includeGuard = {TK_IFNDEF, TK_IDENTIFIER, TK_DEFINE, TK_IDENTIFIER};
 
@@ -34,25 +32,14 @@ void checkIncludeGuard(ErrorFile& errors, const string& path, const vector<Token
               "Include guard name mismatch; expected " + to_string(tokens[1].value_) + ", saw " +
                   to_string(tokens[3].value_));
 
-  int openIf = 1;
-
-  size_t       pos;
-  const size_t size = tokens.size();
-  for (pos = 1; pos < size; ++pos) {
-    if (isTok(tokens[pos], TK_IFNDEF) || isTok(tokens[pos], TK_IFDEF) || isTok(tokens[pos], TK_POUNDIF)) {
-      ++openIf;
-      continue;
-    }
-    if (isTok(tokens[pos], TK_ENDIF)) {
-      --openIf;
-      if (openIf == 0) break;
-      continue;
-    }
-  }
+  // The guard's #ifndef is the first directive; its branches lead to its #endif
+  const vector<Directive>& directives = tokens.directives();
+  const Directive*         guardEnd   = &directives.front();
+  while (guardEnd->next_ != Directive::NONE) guardEnd = &directives[guardEnd->next_];
 
-  if (openIf != 0 || pos < size - 2) {
+  if (guardEnd->kind_ != TK_ENDIF || guardEnd->token_ < tokens.size() - 2)
     lintError(errors, tokens.back(), "Include guard doesn't cover the entire file.");
-    return;
-  }
 };
+
+const CheckTraits traitsIncludeGuard{Lint::ERROR, false, categoryBit(HEADER)};
 }  // namespace flint
@@ -0,0 +1,42 @@
+#include "../Checks.hpp"
+#include "../SequenceMatcher.hpp"
+using namespace std;
+
+namespace flint {
+
+/**
+ * Check all member intializations to make sure they do not initialize on themselves
+ *
+ * @param errors
+ *        Struct to track how many errors/warnings/advice occured
+ * @param path
+ *        The path to the file currently being linted
+ * @param tokens
+ *        The token list for the file
+ */
+void checkInitializeFromItself(ErrorFile&       errors,
+                               const string&    path,
+                               const TokenList& tokens,
+                               const ScopeTree& scopes) {
+  // Token Sequences for parameter initializers
+  static const SequenceMatcher initializers({
+      {TK_COLON, TK_IDENTIFIER, TK_LPAREN, TK_IDENTIFIER, TK_RPAREN},
+      {TK_COMMA, TK_IDENTIFIER, TK_LPAREN, TK_IDENTIFIER, TK_RPAREN},
+  });
+
+  initializers.scan(tokens, 0, tokens.size(), [&](size_t sequence, size_t pos) -> size_t {
+    const size_t outerPos = pos + 1;  // +1 for identifier
+    const size_t innerPos = pos + 3;  // +2 again for the inner identifier
+
+    const bool isMember = tokens[outerPos].value_.back() == '_' || startsWith(tokens[outerPos].value_.begin(), "m_");
+
+    if (isMember && cmpToks(tokens[outerPos], tokens[innerPos]))
+      lintError(errors,
+                tokens[outerPos],
+                "Initializing class member '" + to_string(tokens[outerPos].value_) + "' with itself.");
+    return innerPos + 1;
+  });
+};
+
+const CheckTraits traitsInitializeFromItself{Lint::ERROR, false, ALL_FILE_CATEGORIES};
+}  // namespace flint
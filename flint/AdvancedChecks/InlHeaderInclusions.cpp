@@ -0,0 +1,50 @@
+#include "../Checks.hpp"
+using namespace std;
+
+namespace flint {
+
+/**
+ * Makes sure inl headers are included correctly
+ *
+ * @param errors
+ *        Struct to track how many errors/warnings/advice occured
+ * @param path
+ *        The path to the file currently being linted
+ * @param tokens
+ *        The token list for the file
+ */
+void checkInlHeaderInclusions(ErrorFile&       errors,
+                              const string&    path,
+                              const TokenList& tokens,
+                              const ScopeTree& scopes) {
+  string file(path);
+  size_t fpos = file.find_last_of("/\\");
+  if (fpos != string::npos) file = file.substr(fpos + 1);
+  const string fileBase = getFileNameBase(file);
+
+  string includedFile;
+  for (const Directive& directive: tokens.directives()) {
+    if (directive.kind_ != TK_INCLUDE || !isTok(tokens[directive.token_ + 1], TK_STRING_LITERAL)) continue;
+
+    const StringFragment included{tokens.includedPath(directive)};
+    includedFile.assign(included.begin(), included.end());
+
+    if (getFileCategory(includedFile) != FileCategory::INL_HEADER) continue;
+
+    string       includedName{includedFile};
+    const size_t slash = includedFile.find_last_of("/\\");
+    if (slash != string::npos) includedName = includedFile.substr(slash + 1);
+    string includedBase = getFileNameBase(includedName);
+
+    if (cmpStr(fileBase, includedBase)) continue;
+
+    lintError(errors,
+              tokens[directive.token_ + 1],
+              "An -inl file (" + includedFile + ") was included even though this is not its associated header.",
+              "Usually files like Foo-inl.h are implementation details and should "
+              "not be included outside of Foo.h.");
+  }
+};
+
+const CheckTraits traitsInlHeaderInclusions{Lint::ERROR, false, ALL_FILE_CATEGORIES};
+}  // namespace flint
@@ -0,0 +1,49 @@
+#include "../Checks.hpp"
+using namespace std;
+
+namespace flint {
+
+/**
+ * Check for static variables and functions in global/namespace scopes
+ *
+ * @param errors
+ *        Struct to track how many errors/warnings/advice occured
+ * @param path
+ *        The path to the file currently being linted
+ * @param tokens
+ *        The token list for the file
+ */
+void checkNamespaceScopedStatics(ErrorFile&       errors,
+                                 const string&    path,
+                                 const TokenList& tokens,
+                                 const ScopeTree& scopes) {
+  static constexpr array<TokenType, 2> usingNamespace{TK_USING, TK_NAMESPACE};
+
+  // Only namespaces may lie between the token and the file
+  const auto atNamespaceScope = [&scopes](size_t pos) {
+    size_t index = scopes.innermost(pos);
+    while (index != 0 && scopes[index].kind_ == ScopeKind::NAMESPACE) index = scopes[index].parent_;
+    return index == 0;
+  };
+
+  // Visit the statics and usings in the order of the file
+  const vector<uint32_t>& statics    = tokens.positions(TK_STATIC);
+  const vector<uint32_t>& usings     = tokens.positions(TK_USING);
+  auto                    nextStatic = statics.begin();
+  auto                    nextUsing  = usings.begin();
+  while (nextStatic != statics.end() || nextUsing != usings.end()) {
+    const bool   isStatic = nextUsing == usings.end() || (nextStatic != statics.end() && *nextStatic < *nextUsing);
+    const size_t pos      = isStatic ? *nextStatic++ : *nextUsing++;
+    if (!atNamespaceScope(pos)) continue;
+
+    if (isStatic) lintWarning(errors, tokens[pos], "Don't use static at global or namespace scopes in headers.");
+
+    // Checking for 'using namespace' violations here as well
+    if (atSequence(tokens, pos, usingNamespace))
+      lintWarning(
+          errors, tokens[pos], "Avoid the use of using namespace directives at global/namespace scope in headers");
+  }
+};
+
+const CheckTraits traitsNamespaceScopedStatics{Lint::WARNING, false, categoryBit(HEADER) | categoryBit(INL_HEADER)};
+}  // namespace flint
@@ -13,26 +13,29 @@ namespace flint {
  * @param tokens
  *        The token list for the file
  */
-void checkProtectedInheritance(ErrorFile&            errors,
-                               const string&         path,
-                               const vector<Token>&  tokens,
-                               const vector<size_t>& structures) {
+void checkProtectedInheritance(ErrorFile&       errors,
+                               const string&    path,
+                               const TokenList& tokens,
+                               const ScopeTree& scopes) {
   static constexpr array<TokenType, 3> protectedSequence{TK_COLON, TK_PROTECTED, TK_IDENTIFIER};
 
-  const size_t toksize = tokens.size();
-  for (auto pos: structures) {
-    for (; pos < toksize - 2; ++pos) {
-      if (isTok(tokens[pos], TK_LCURL) || isTok(tokens[pos], TK_SEMICOLON)) break;
+  if (tokens.count(TK_PROTECTED) == 0) return;
 
-      if (atSequence(tokens, pos, protectedSequence))
-        lintWarning(errors,
-                    tokens[pos],
-                    "Protected inheritance is sometimes not a good idea.",
-                    "Read "
-                    "http://stackoverflow.com/questions/6484306/"
-                    "effective-c-discouraging-protected-inheritance "
-                    "for more information.");
-    }
+  for (const Scope& scope: scopes.scopes()) {
+    // Only the first base class is looked at
+    if (scope.bases_ == Scope::NO_TOKEN) continue;
+
+    const size_t pos = scope.bases_;
+    if (atSequence(tokens, pos, protectedSequence))
+      lintWarning(errors,
+                  tokens[pos],
+                  "Protected inheritance is sometimes not a good idea.",
+                  "Read "
+                  "http://stackoverflow.com/questions/6484306/"
+                  "effective-c-discouraging-protected-inheritance "
+                  "for more information.");
   }
 };
+
+const CheckTraits traitsProtectedInheritance{Lint::WARNING, true, ALL_FILE_CATEGORIES};
 }  // namespace flint
@@ -19,10 +19,13 @@ namespace flint {
  * @param tokens
  *        The token list for the file
  */
-void checkThrowSpecification(ErrorFile&            errors,
-                             const string&         path,
-                             const vector<Token>&  tokens,
-                             const vector<size_t>& structures) {
+void checkThrowSpecification(ErrorFile&       errors,
+                             const string&    path,
+                             const TokenList& tokens,
+                             const ScopeTree& scopes) {
+  // Nothing to report without a throw
+  if (tokens.count(TK_THROW) == 0) return;
+
   auto numTokens = tokens.size();
   auto posLimit  = numTokens - 1;
 
@@ -31,12 +34,10 @@ void checkThrowSpecification(ErrorFile&            errors,
   static constexpr array<TokenType, 6> whatSequence{TK_LPAREN, TK_RPAREN, TK_CONST, TK_THROW, TK_LPAREN, TK_RPAREN};
 
   // Check for throw specifications inside classes
-  for (auto pos: structures) {
-    // Skip to opening '{'
-    if (!skipToToken(tokens, pos, TK_LCURL)) { continue; }
-    ++pos;
+  for (const Scope& scope: scopes.scopes()) {
+    if (!scope.isClass()) continue;
 
-    for (; pos < numTokens && !isTok(tokens[pos], TK_EOF); ++pos) {
+    for (size_t pos = scope.open_ + 1; pos < scope.close_; ++pos) {
       const auto tok = tokens[pos];
 
       // Skip warnings for empty throw specifications on destructors,
@@ -49,7 +50,7 @@ void checkThrowSpecification(ErrorFile&            errors,
 
       // This avoids warning if the function is named "what", to allow
       // inheriting from std::exception without upsetting lint.
-      if (isTok(tok, TK_IDENTIFIER) && cmpTok(tok, "what")) {
+      if (tok.symbol() == SYM_WHAT) {
         ++pos;
         if (atSequence(tokens, pos, whatSequence)) pos += whatSequence.size();
         continue;
@@ -61,9 +62,6 @@ void checkThrowSpecification(ErrorFile&            errors,
         continue;
       }
 
-      // If we actually find a closing one we know it's the object's closing bracket
-      if (isTok(tok, TK_RCURL)) break;
-
       // Because we skip the bodies of functions the only throws we should find are function throws
       if (pos < posLimit && isTok(tok, TK_THROW) && isTok(tokens[pos + 1], TK_LPAREN)) {
         lintWarning(errors, tok, "Throw specifications on functions are deprecated.");
@@ -72,34 +70,22 @@ void checkThrowSpecification(ErrorFile&            errors,
     }
   }
 
-  // Check for throw specifications in functional style code
+  // Check for throw specifications in functional style code, outside of
+  // namespaces, classes, and blocks
+  size_t next = 1;  // The next scope directly inside the file
   for (size_t pos = 0; pos < numTokens; ++pos) {
-    const auto tok = tokens[pos];
-
-    // Don't accidentally identify a using statement as a namespace
-    if (isTok(tok, TK_USING)) {
-      if (isTok(tokens[pos + 1], TK_NAMESPACE)) { ++pos; }
+    if (next < scopes.size() && pos >= scopes[next].head_) {
+      pos  = scopes[next].close_;
+      next = scopes[next].end_;
       continue;
     }
 
-    // Skip namespaces, classes, and blocks
-    if (isTok(tok, TK_NAMESPACE) || isTok(tok, TK_CLASS) || isTok(tok, TK_STRUCT) || isTok(tok, TK_UNION) ||
-        isTok(tok, TK_LCURL)) {
-      // Move to opening object '{'
-      for (; !isTok(tokens[pos], TK_LCURL) && !isTok(tokens[pos], TK_EOF); ++pos) {}
-
-      // Return if we didn't find a '{'
-      if (!isTok(tokens[pos], TK_LCURL)) return;
-
-      // Skip to closing '}'
-      pos = skipBlock(tokens, pos);
-    }
-
     // Because we skip the bodies of functions the only throws we should find are function throws
-    if (isTok(tok, TK_THROW) && isTok(tokens[pos + 1], TK_LPAREN)) {
+    const auto tok = tokens[pos];
+    if (pos < posLimit && isTok(tok, TK_THROW) && isTok(tokens[pos + 1], TK_LPAREN))
       lintWarning(errors, tok, "Throw specifications on functions are deprecated.");
-      continue;
-    }
   }
 };
+
+const CheckTraits traitsThrowSpecification{Lint::WARNING, true, ALL_FILE_CATEGORIES};
 }  // namespace flint
@@ -13,55 +13,51 @@ namespace flint {
  * @param tokens
  *        The token list for the file
  */
-void checkVirtualDestructors(ErrorFile&            errors,
-                             const string&         path,
-                             const vector<Token>&  tokens,
-                             const vector<size_t>& structures) {
-  static constexpr array<TokenType, 3> accessSpecifiers{TK_PUBLIC, TK_PRIVATE, TK_PROTECTED};
-
+void checkVirtualDestructors(ErrorFile&       errors,
+                             const string&    path,
+                             const TokenList& tokens,
+                             const ScopeTree& scopes) {
   static const string msg{"Classes with virtual functions should not have a public non-virtual destructor."};
 
-  auto size        = structures.size();
-  auto penultimate = size - 1;
-  for (size_t i = 0; i < size; ++i) {
-    auto startIter = begin(tokens) + structures[i];
-    auto endIter   = (i == penultimate) ? end(tokens) : begin(tokens) + structures[i + 1];
-
-    const auto& tok = *startIter;
-
-    if (isTok(tok, TK_UNION)) continue;
-
-    // Start at end of class definition to avoid virtual bases
-    const auto endOfClass = getEndOfClass(startIter + 1, endIter);
-    if (endOfClass == endIter || !isTok(*endOfClass, TK_LCURL)) continue;
-
-    // Find something virtual
-    const auto virtualLocation =
-        find_if(endOfClass + 1, endIter, [](const Token& token) { return isTok(token, TK_VIRTUAL); });
-    if (virtualLocation == endIter) continue;  // No virtual functions or destructor
-
-    // Now that we have something virtual, we need a destructor
-    const auto userDestructor = adjacent_find(startIter, endIter, [](const Token& first, const Token& second) {
-      return isTok(first, TK_TILDE) && isTok(second, TK_IDENTIFIER);
-    });
+  // Only classes with something virtual are of interest
+  if (tokens.count(TK_VIRTUAL) == 0) return;
+
+  for (size_t index = 1; index < scopes.size(); ++index) {
+    const Scope& scope = scopes[index];
+    if (!(scope.kind_ == ScopeKind::STRUCT || scope.kind_ == ScopeKind::CLASS)) continue;
+
+    // Look through the members for something virtual and a destructor,
+    // past the bases (which may be virtual) and over anything nested
+    bool   hasVirtual = false;
+    size_t destructor = Scope::NO_TOKEN;
+    size_t next       = index + 1;  // The next scope directly inside this one
+    for (size_t pos = scope.open_ + 1; pos < scope.close_; ++pos) {
+      if (next < scope.end_ && pos >= scopes[next].head_) {
+        pos  = scopes[next].close_;
+        next = scopes[next].end_;
+        continue;
+      }
+
+      if (isTok(tokens[pos], TK_VIRTUAL))
+        hasVirtual = true;
+      else if (destructor == Scope::NO_TOKEN && isTok(tokens[pos], TK_TILDE) && isTok(tokens[pos + 1], TK_IDENTIFIER))
+        destructor = pos;
+    }
+    if (!hasVirtual) continue;  // No virtual functions or destructor
 
     // compiler defined is not virtual
-    if (userDestructor == endIter) {
-      lintWarning(errors, *startIter, msg);
+    if (destructor == Scope::NO_TOKEN) {
+      lintWarning(errors, tokens[scope.head_], msg);
       continue;
     }
 
     // We're good, we've got a virtual destructor
-    if (isTok(*(userDestructor - 1), TK_VIRTUAL)) continue;
+    if (isTok(tokens[destructor - 1], TK_VIRTUAL)) continue;
 
     // Now what kind of access do we have for our virtual destructor
-    using rev_iter        = reverse_iterator<TokenIter>;
-    const auto lastAccess = find_first_of(
-        rev_iter(userDestructor), rev_iter(startIter), begin(accessSpecifiers), end(accessSpecifiers), isTok);
-    const auto access =
-        (lastAccess != rev_iter(startIter)) ? lastAccess->type_ : isTok(tok, TK_STRUCT) ? TK_PUBLIC : TK_PRIVATE;
-
-    if (access == TK_PUBLIC) lintWarning(errors, *startIter, msg);
+    if (scopes.accessAt(index, destructor) == TK_PUBLIC) lintWarning(errors, tokens[scope.head_], msg);
   }
 };
+
+const CheckTraits traitsVirtualDestructors{Lint::WARNING, true, ALL_FILE_CATEGORIES};
 }  // namespace flint
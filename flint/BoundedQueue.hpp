@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace flint {
+
+/*
+ * How busy a queue between two pipeline stages was
+ *
+ * A producer stall means the consumers could not keep up, a consumer stall
+ * means the producers could not; the time spent stalled says by how much.
+ */
+struct QueueStats {
+  size_t capacity{0};
+  size_t pushes{0};
+  size_t depthSum{0};  // queue depth seen by each push, for the average
+  size_t maxDepth{0};
+  size_t pushStalls{0}, popStalls{0};
+  double pushStallSecs{0}, popStallSecs{0};
+};
+
+/*
+ * A FIFO queue of fixed capacity for handing work from one stage to the next
+ *
+ * push() blocks while the queue is full and pop() while it is empty, so a
+ * fast stage can never run arbitrarily far ahead of a slow one. Once close()
+ * has been called, pop() drains what is left and then returns false.
+ */
+template<typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(size_t capacity) { m_stats.capacity = capacity; };
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  auto operator=(const BoundedQueue&) -> BoundedQueue& = delete;
+
+  void push(T item) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_items.size() >= m_stats.capacity) {
+      const auto start = std::chrono::steady_clock::now();
+      m_notFull.wait(lock, [this] { return m_items.size() < m_stats.capacity; });
+      ++m_stats.pushStalls;
+      m_stats.pushStallSecs += secondsSince(start);
+    }
+    m_items.push_back(std::move(item));
+
+    ++m_stats.pushes;
+    m_stats.depthSum += m_items.size();
+    if (m_items.size() > m_stats.maxDepth) m_stats.maxDepth = m_items.size();
+
+    lock.unlock();
+    m_notEmpty.notify_one();
+  };
+
+  auto pop(T& item) -> bool {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_items.empty() && !m_closed) {
+      const auto start = std::chrono::steady_clock::now();
+      m_notEmpty.wait(lock, [this] { return !m_items.empty() || m_closed; });
+      ++m_stats.popStalls;
+      m_stats.popStallSecs += secondsSince(start);
+    }
+    if (m_items.empty()) return false;
+
+    item = std::move(m_items.front());
+    m_items.pop_front();
+
+    lock.unlock();
+    m_notFull.notify_one();
+    return true;
+  };
+
+  // No more items will be pushed; wakes every waiting consumer
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_closed = true;
+    }
+    m_notEmpty.notify_all();
+  };
+
+  auto stats() -> QueueStats {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+  };
+
+ private:
+  static auto secondsSince(std::chrono::steady_clock::time_point start) -> double {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  std::mutex              m_mutex;
+  std::condition_variable m_notFull, m_notEmpty;
+  std::deque<T>           m_items;
+  bool                    m_closed{false};
+  QueueStats              m_stats;
+};
+};  // namespace flint
@@ -0,0 +1,197 @@
+#include "ByteScan.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FLINT_SCAN_SSE2
+#endif
+
+// AVX2 is only compiled in where the compiler can target it per function
+#if defined(FLINT_SCAN_SSE2) && defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define FLINT_SCAN_AVX2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace flint {
+
+namespace {
+inline auto countBits(unsigned mask) -> size_t {
+#ifdef _MSC_VER
+  return __popcnt(mask);
+#else
+  return static_cast<size_t>(__builtin_popcount(mask));
+#endif
+};
+
+inline auto lowestBit(unsigned mask) -> size_t {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+};
+
+// *** Portable fallbacks, also used for the tail of the text past the last whole block
+
+auto scanForScalar(const char* p, const char* last, char a, char b) -> const char* {
+  (void)last;  // the '\0' stops the loop
+  while (*p != a && *p != b && *p != '\0') ++p;
+  return p;
+};
+
+auto scanForCountingLinesScalar(const char* p, const char* last, char a, char b, size_t& lines) -> const char* {
+  (void)last;
+  for (; *p != a && *p != b && *p != '\0'; ++p) lines += (*p == '\n');
+  return p;
+};
+
+auto skipBlanksScalar(const char* p, const char* last) -> const char* {
+  (void)last;
+  while (*p == ' ' || *p == '\t') ++p;
+  return p;
+};
+
+#ifdef FLINT_SCAN_SSE2
+// *** SSE2, which every x86-64 CPU has
+
+auto scanForSSE2(const char* p, const char* last, char a, char b) -> const char* {
+  const __m128i wantA = _mm_set1_epi8(a), wantB = _mm_set1_epi8(b), zero = _mm_setzero_si128();
+  for (; last - p >= 15; p += 16) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i stop  = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, wantA), _mm_cmpeq_epi8(block, wantB)),
+                                      _mm_cmpeq_epi8(block, zero));
+    const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(stop));
+    if (mask) return p + lowestBit(mask);
+  }
+  return scanForScalar(p, last, a, b);
+};
+
+auto scanForCountingLinesSSE2(const char* p, const char* last, char a, char b, size_t& lines) -> const char* {
+  const __m128i wantA = _mm_set1_epi8(a), wantB = _mm_set1_epi8(b), zero = _mm_setzero_si128();
+  const __m128i newline = _mm_set1_epi8('\n');
+  for (; last - p >= 15; p += 16) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i stop  = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, wantA), _mm_cmpeq_epi8(block, wantB)),
+                                      _mm_cmpeq_epi8(block, zero));
+    const unsigned mask  = static_cast<unsigned>(_mm_movemask_epi8(stop));
+    unsigned       lfs   = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)));
+    if (mask) {
+      // Only the newlines before the stop were skipped
+      lfs &= (1u << lowestBit(mask)) - 1;
+      if (lfs) lines += countBits(lfs);
+      return p + lowestBit(mask);
+    }
+    if (lfs) lines += countBits(lfs);
+  }
+  return scanForCountingLinesScalar(p, last, a, b, lines);
+};
+
+auto skipBlanksSSE2(const char* p, const char* last) -> const char* {
+  const __m128i space = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t');
+  for (; last - p >= 15; p += 16) {
+    const __m128i  block  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i  blank  = _mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab));
+    const unsigned others = ~static_cast<unsigned>(_mm_movemask_epi8(blank)) & 0xFFFFu;
+    if (others) return p + lowestBit(others);
+  }
+  return skipBlanksScalar(p, last);
+};
+#endif
+
+#ifdef FLINT_SCAN_AVX2
+// *** AVX2, used when the CPU running us has it
+
+__attribute__((target("avx2"))) auto scanForAVX2(const char* p, const char* last, char a, char b) -> const char* {
+  const __m256i wantA = _mm256_set1_epi8(a), wantB = _mm256_set1_epi8(b), zero = _mm256_setzero_si256();
+  for (; last - p >= 31; p += 32) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i stop  = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, wantA), _mm256_cmpeq_epi8(block, wantB)),
+        _mm256_cmpeq_epi8(block, zero));
+    const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(stop));
+    if (mask) return p + __builtin_ctz(mask);
+  }
+  return scanForSSE2(p, last, a, b);
+};
+
+__attribute__((target("avx2,popcnt"))) auto scanForCountingLinesAVX2(const char* p,
+                                                                      const char* last,
+                                                                      char        a,
+                                                                      char        b,
+                                                                      size_t&     lines) -> const char* {
+  const __m256i wantA = _mm256_set1_epi8(a), wantB = _mm256_set1_epi8(b), zero = _mm256_setzero_si256();
+  const __m256i newline = _mm256_set1_epi8('\n');
+  for (; last - p >= 31; p += 32) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i stop  = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, wantA), _mm256_cmpeq_epi8(block, wantB)),
+        _mm256_cmpeq_epi8(block, zero));
+    const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(stop));
+    unsigned       lfs  = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline)));
+    if (mask) {
+      // Only the newlines before the stop were skipped
+      const unsigned at = static_cast<unsigned>(__builtin_ctz(mask));
+      lines += static_cast<size_t>(__builtin_popcount(at < 31 ? lfs & ((1u << at) - 1) : lfs & 0x7FFFFFFFu));
+      return p + at;
+    }
+    lines += static_cast<size_t>(__builtin_popcount(lfs));
+  }
+  return scanForCountingLinesSSE2(p, last, a, b, lines);
+};
+
+__attribute__((target("avx2"))) auto skipBlanksAVX2(const char* p, const char* last) -> const char* {
+  const __m256i space = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t');
+  for (; last - p >= 31; p += 32) {
+    const __m256i  block  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i  blank  = _mm256_or_si256(_mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, tab));
+    const unsigned others = ~static_cast<unsigned>(_mm256_movemask_epi8(blank));
+    if (others) return p + __builtin_ctz(others);
+  }
+  return skipBlanksSSE2(p, last);
+};
+#endif
+
+/*
+ * The implementations picked for this CPU
+ */
+struct Scanners {
+  auto (*scanFor)(const char*, const char*, char, char) -> const char*;
+  auto (*scanForCountingLines)(const char*, const char*, char, char, size_t&) -> const char*;
+  auto (*skipBlanks)(const char*, const char*) -> const char*;
+};
+
+auto pickScanners() -> Scanners {
+#ifdef FLINT_SCAN_AVX2
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return {scanForAVX2, scanForCountingLinesAVX2, skipBlanksAVX2};
+#endif
+#ifdef FLINT_SCAN_SSE2
+  return {scanForSSE2, scanForCountingLinesSSE2, skipBlanksSSE2};
+#else
+  return {scanForScalar, scanForCountingLinesScalar, skipBlanksScalar};
+#endif
+};
+
+const Scanners scanners = pickScanners();
+};  // namespace
+
+auto scanFor(const char* p, const char* last, char a, char b) -> const char* {
+  return scanners.scanFor(p, last, a, b);
+};
+
+auto scanForCountingLines(const char* p, const char* last, char a, char b, size_t& lines) -> const char* {
+  return scanners.scanForCountingLines(p, last, a, b, lines);
+};
+
+auto skipBlanks(const char* p, const char* last) -> const char* {
+  // Most runs of blanks are a single space, not worth loading a block for
+  if (*p != ' ' && *p != '\t') return p;
+  if (p[1] != ' ' && p[1] != '\t') return p + 1;
+  return scanners.skipBlanks(p + 2, last);
+};
+};  // namespace flint
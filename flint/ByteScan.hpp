@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+
+namespace flint {
+
+/*
+ * Vectorized searches used by the tokenizer to skip over comments, string
+ * literals and runs of blanks without looking at one byte at a time
+ *
+ * Each search reads the text in blocks of 16 (SSE2) or 32 (AVX2) bytes, the
+ * widest the CPU supports being picked once at startup; other platforms use
+ * a plain loop. The text is scanned up to and including `last`, which must
+ * point at the '\0' terminating it, and no byte past it is ever read.
+ */
+
+/**
+ * Finds the first occurrence of either of two bytes, or of a '\0'
+ *
+ * @param p
+ *        Where to start searching
+ * @param last
+ *        The terminating '\0' of the text
+ * @param a
+ *        A byte to stop at
+ * @param b
+ *        Another byte to stop at (may equal a)
+ * @return
+ *        Returns a pointer to the first a, b or '\0' at or after p
+ */
+auto scanFor(const char* p, const char* last, char a, char b) -> const char*;
+
+/**
+ * Like scanFor(), also counting the newlines skipped on the way
+ *
+ * @param lines
+ *        Incremented by the number of '\n' bytes before the result
+ */
+auto scanForCountingLines(const char* p, const char* last, char a, char b, size_t& lines) -> const char*;
+
+/**
+ * Skips spaces and tabs
+ *
+ * @return
+ *        Returns a pointer to the first byte at or after p that is neither
+ */
+auto skipBlanks(const char* p, const char* last) -> const char*;
+};  // namespace flint
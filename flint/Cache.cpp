@@ -0,0 +1,325 @@
+#include "Cache.hpp"
+
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include "Config.hpp"
+#include "ErrorReport.hpp"
+#include "FileCategories.hpp"
+#include "Options.hpp"
+#include "Polyfill.hpp"
+#include "Registry.hpp"
+#include "Stats.hpp"
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace flint {
+
+namespace {
+// Bump this whenever a check changes what it reports, so that results
+// cached by older builds are not reused
+constexpr uint64_t kCacheRevision = 2;
+
+const char kIndexMagic[]  = "FLINTIX1";
+const char kResultMagic[] = "FLINTRS1";
+
+// Stat data this recent may not tell a later edit apart (see git's "racy clean")
+constexpr int64_t kRacySeconds = 2;
+
+/**
+ * Hashes everything besides a file's contents and path that decides
+ * what the checks report
+ */
+auto checkerStamp() -> uint64_t {
+  string stamp = "revision " + std::to_string(kCacheRevision) + '\n';
+  stamp += Plan.describe();
+  stamp += Options.CMODE ? "C mode\n" : "C++ mode\n";
+  stamp += "level " + std::to_string(Options.LEVEL) + '\n';
+  stamp += "config\n" + Config.source();
+  return hashBytes(stamp.data(), stamp.size());
+};
+
+auto toHex(uint64_t value) -> string {
+  char buffer[17];
+  snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+  return buffer;
+};
+
+/**
+ * Fills in the stat data of a probe
+ *
+ * @return
+ *        Returns false if the file could not be stat'ed
+ */
+auto statFile(CacheProbe& probe) -> bool {
+  struct stat info;
+  ++Stats.statCalls;
+  if (stat(probe.path.c_str(), &info) != 0) return false;
+
+  constexpr int64_t kNano = 1000000000;
+#if defined(__APPLE__)
+  probe.mtime = info.st_mtimespec.tv_sec * kNano + info.st_mtimespec.tv_nsec;
+  probe.ctime = info.st_ctimespec.tv_sec * kNano + info.st_ctimespec.tv_nsec;
+#elif defined(_WIN32)
+  probe.mtime = static_cast<int64_t>(info.st_mtime) * kNano;
+  probe.ctime = static_cast<int64_t>(info.st_ctime) * kNano;
+#else
+  probe.mtime = info.st_mtim.tv_sec * kNano + info.st_mtim.tv_nsec;
+  probe.ctime = info.st_ctim.tv_sec * kNano + info.st_ctim.tv_nsec;
+#endif
+  probe.size    = static_cast<uint64_t>(info.st_size);
+  probe.inode   = static_cast<uint64_t>(info.st_ino);
+  probe.statted = true;
+  return true;
+};
+
+// Serialization of cache entries; they never leave the machine, so host byte order will do
+void put(string& out, uint64_t value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+};
+
+void put(string& out, const string& value) {
+  put(out, static_cast<uint64_t>(value.size()));
+  out += value;
+};
+
+/*
+ * Reads back what put() wrote, failing (rather than overrunning)
+ * on anything truncated or corrupt
+ */
+struct EntryReader {
+  const char* pos;
+  const char* end;
+  bool        ok{true};
+
+  explicit EntryReader(const string& entry): pos(entry.data()), end(entry.data() + entry.size()){};
+
+  auto magic(const char* expected) -> bool {
+    const size_t size = strlen(expected);
+    ok                = ok && static_cast<size_t>(end - pos) >= size && memcmp(pos, expected, size) == 0;
+    if (ok) pos += size;
+    return ok;
+  };
+
+  auto u64() -> uint64_t {
+    uint64_t value = 0;
+    ok             = ok && static_cast<size_t>(end - pos) >= sizeof(value);
+    if (ok) {
+      memcpy(&value, pos, sizeof(value));
+      pos += sizeof(value);
+    }
+    return value;
+  };
+
+  auto str() -> string {
+    const uint64_t size = u64();
+    ok                  = ok && static_cast<uint64_t>(end - pos) >= size;
+    if (!ok) return string();
+    string value(pos, static_cast<size_t>(size));
+    pos += size;
+    return value;
+  };
+};
+};  // namespace
+
+ResultCache::ResultCache(string dir): m_dir(move(dir)) {
+  while (m_dir.size() > 1 && (m_dir.back() == '/' || m_dir.back() == '\\')) m_dir.pop_back();
+
+  m_usable = fsMakeDir(m_dir) && fsMakeDir(m_dir + FS_SEP + "index") && fsMakeDir(m_dir + FS_SEP + "results") &&
+             fsMakeDir(m_dir + FS_SEP + "tmp");
+  if (!m_usable) {
+    fprintf(stderr, "Cannot use cache directory '%s'; linting without it.\n\n", m_dir.c_str());
+    return;
+  }
+
+  m_cwd   = fsCurrentDir();
+  m_stamp = checkerStamp();
+};
+
+auto ResultCache::lookup(const string& path, CacheProbe& probe, LintResult& result) -> bool {
+  probe      = CacheProbe();
+  probe.path = path;
+
+  // The index is per file, not per path spelling, so it is keyed by the absolute path
+  const string absolute = fsIsAbsolute(path) ? path : m_cwd + FS_SEP + path;
+  const string key      = toHex(hashBytes(absolute.data(), absolute.size()));
+  probe.indexName       = string("index") + FS_SEP + key.substr(0, 2) + FS_SEP + key;
+
+  string entry;
+  if (!statFile(probe) || !readEntry(probe.indexName, entry)) return false;
+
+  EntryReader in(entry);
+  in.magic(kIndexMagic);
+  const bool same = in.str() == absolute && static_cast<int64_t>(in.u64()) == probe.mtime &&
+                    static_cast<int64_t>(in.u64()) == probe.ctime && in.u64() == probe.size &&
+                    in.u64() == probe.inode;
+  const uint64_t contentHash = in.u64();
+  if (!in.ok || !same) return false;
+
+  // Unchanged since it was last hashed; the contents need not even be read
+  probe.hashed      = true;
+  probe.contentHash = contentHash;
+  probe.indexed     = true;
+
+  if (!readResult(probe, result)) return false;
+  ++m_statHits;
+  return true;
+};
+
+auto ResultCache::lookup(CacheProbe& probe, const char* begin, const char* end, LintResult& result) -> bool {
+  if (!probe.hashed) {
+    probe.contentHash = hashBytes(begin, static_cast<size_t>(end - begin));
+    probe.hashed      = true;
+  }
+
+  if (!readResult(probe, result)) {
+    ++m_misses;
+    return false;
+  }
+
+  ++m_hashHits;
+  storeIndex(probe);
+  return true;
+};
+
+void ResultCache::store(const CacheProbe& probe, const LintResult& result) {
+  if (!probe.hashed || !result.file) return;
+
+  string entry{kResultMagic};
+  put(entry, m_stamp);
+  put(entry, probe.contentHash);
+  put(entry, probe.path);
+  put(entry, static_cast<uint64_t>(result.loc));
+
+  const auto& objects = result.file->getErrorObjects();
+  put(entry, static_cast<uint64_t>(objects.size()));
+  for (const auto& object: objects) {
+    put(entry, static_cast<uint64_t>(object.getType()));
+    put(entry, static_cast<uint64_t>(object.getLine()));
+    put(entry, object.getTitle());
+    put(entry, object.getDesc());
+  }
+  writeEntry(resultName(probe), entry);
+
+  storeIndex(probe);
+};
+
+void ResultCache::printSummary() const {
+  const size_t statHits = m_statHits, hits = statHits + m_hashHits, total = hits + m_misses;
+  const double rate     = total ? 100.0 * static_cast<double>(hits) / static_cast<double>(total) : 0;
+  fprintf(stderr,
+          "Cache: %zu of %zu files reused (%.1f%% hit rate), %zu of them without being read\n",
+          hits,
+          total,
+          rate,
+          statHits);
+};
+
+/**
+ * Looks up the results for the contents a probe has hashed
+ *
+ * @return
+ *        Returns true if they were found, in which case result is filled in
+ */
+auto ResultCache::readResult(const CacheProbe& probe, LintResult& result) const -> bool {
+  string entry;
+  if (!readEntry(resultName(probe), entry)) return false;
+
+  EntryReader in(entry);
+  in.magic(kResultMagic);
+  // Guard against the (astronomically unlikely) collision of two entry names
+  const bool same = in.u64() == m_stamp && in.u64() == probe.contentHash && in.str() == probe.path;
+  if (!in.ok || !same) return false;
+
+  const size_t          loc = static_cast<size_t>(in.u64());
+  unique_ptr<ErrorFile> file{new ErrorFile(Options.VERBOSE ? probe.path : getFileName(probe.path))};
+  for (uint64_t i = 0, count = in.u64(); in.ok && i < count; ++i) {
+    const uint64_t type  = in.u64();
+    const uint64_t line  = in.u64();
+    string         title = in.str();
+    string         desc  = in.str();
+    if (!in.ok || type > Lint::ADVICE) return false;
+    file->addError(ErrorObject(static_cast<Lint>(type), static_cast<size_t>(line), move(title), move(desc)));
+  }
+  if (!in.ok) return false;
+
+  result.loc  = loc;
+  result.file = move(file);
+  return true;
+};
+
+/**
+ * Remembers which contents a file's current stat data stands for
+ */
+void ResultCache::storeIndex(const CacheProbe& probe) {
+  if (probe.indexed || !probe.statted || !probe.hashed) return;
+
+  // A file modified within the last moment could be modified again without
+  // its stat data changing; only the content hash can be trusted for it
+  const int64_t now = static_cast<int64_t>(time(nullptr));
+  if (max(probe.mtime, probe.ctime) / 1000000000 >= now - kRacySeconds) return;
+
+  const string absolute = fsIsAbsolute(probe.path) ? probe.path : m_cwd + FS_SEP + probe.path;
+  string       entry{kIndexMagic};
+  put(entry, absolute);
+  put(entry, static_cast<uint64_t>(probe.mtime));
+  put(entry, static_cast<uint64_t>(probe.ctime));
+  put(entry, probe.size);
+  put(entry, probe.inode);
+  put(entry, probe.contentHash);
+  writeEntry(probe.indexName, entry);
+};
+
+auto ResultCache::resultName(const CacheProbe& probe) const -> string {
+  const string id  = probe.path + '\0' + toHex(probe.contentHash);
+  const string key = toHex(hashBytes(id.data(), id.size(), m_stamp));
+  return string("results") + FS_SEP + key.substr(0, 2) + FS_SEP + key;
+};
+
+auto ResultCache::readEntry(const string& name, string& contents) const -> bool {
+  FILE* file = fopen((m_dir + FS_SEP + name).c_str(), "rb");
+  if (!file) return false;
+
+  contents.clear();
+  char buffer[4096];
+  while (const size_t got = fread(buffer, 1, sizeof(buffer), file)) contents.append(buffer, got);
+  const bool ok = !ferror(file);
+  fclose(file);
+  return ok;
+};
+
+/**
+ * Writes an entry under a temporary name, then renames it into place
+ */
+void ResultCache::writeEntry(const string& name, const string& contents) {
+  // Unique across the threads of this process and, through the pid and
+  // clock, across the other processes sharing the directory
+  const uint64_t nonce = static_cast<uint64_t>(chrono::steady_clock::now().time_since_epoch().count());
+  const string   temp  = m_dir + FS_SEP + "tmp" + FS_SEP + std::to_string(getpid()) + '-' +
+                      std::to_string(m_tempFiles++) + '-' + toHex(nonce);
+
+  FILE* file = fopen(temp.c_str(), "wb");
+  if (!file) return;
+  bool ok = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+  ok      = (fclose(file) == 0) && ok;
+
+  const string target = m_dir + FS_SEP + name;
+  if (ok && !fsReplaceFile(temp, target)) {
+    // The first entry in a fan-out directory creates it
+    fsMakeDir(target.substr(0, target.find_last_of(FS_SEP)));
+    ok = fsReplaceFile(temp, target);
+  }
+  if (!ok) remove(temp.c_str());
+};
+};  // namespace flint
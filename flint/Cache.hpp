@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "Linter.hpp"
+
+namespace flint {
+
+/*
+ * What the cache has learned about one file so far
+ */
+struct CacheProbe {
+  std::string path;
+  std::string indexName;  // entry mapping the file's stat data to its content hash
+  bool        statted{false};
+  int64_t     mtime{0}, ctime{0};  // nanoseconds
+  uint64_t    size{0}, inode{0};
+  bool        hashed{false};
+  uint64_t    contentHash{0};
+  bool        indexed{false};  // the index entry already matches the stat data
+};
+
+/*
+ * Lint results kept on disk between runs (--cache DIR)
+ *
+ * A file's results are keyed by a hash of its contents, its path (checks
+ * look at the file name), the options that decide which checks run, and a
+ * stamp of the set of checks built into this binary. A second index maps a
+ * file's stat data to its content hash, so unchanged files are not even read.
+ *
+ * Entries are written to a temporary file and renamed into place, so any
+ * number of flint++ processes can share a cache directory: readers see a
+ * whole entry or none at all, and anything unreadable is simply a miss.
+ */
+class ResultCache {
+ public:
+  explicit ResultCache(std::string dir);
+
+  ResultCache(const ResultCache&) = delete;
+  auto operator=(const ResultCache&) -> ResultCache& = delete;
+
+  auto usable() const -> bool { return m_usable; };
+
+  /**
+   * Tries to find a file's results from its stat data alone
+   *
+   * @param path
+   *        The file to look up
+   * @param probe
+   *        Filled with what was learned, for the calls below
+   * @param result
+   *        Filled with the cached results on a hit
+   * @return
+   *        Returns true on a hit
+   */
+  auto lookup(const std::string& path, CacheProbe& probe, LintResult& result) -> bool;
+
+  /**
+   * Tries to find a file's results from its contents
+   *
+   * @param probe
+   *        What the first lookup learned; gains the content hash
+   * @param begin
+   *        The start of the file's contents
+   * @param end
+   *        The end of the file's contents
+   * @param result
+   *        Filled with the cached results on a hit
+   * @return
+   *        Returns true on a hit
+   */
+  auto lookup(CacheProbe& probe, const char* begin, const char* end, LintResult& result) -> bool;
+
+  /**
+   * Stores the results of a file that missed both lookups
+   *
+   * @param probe
+   *        What the lookups learned
+   * @param result
+   *        The results to store
+   */
+  void store(const CacheProbe& probe, const LintResult& result);
+
+  // Prints the hit rate to stderr
+  void printSummary() const;
+
+ private:
+  auto readEntry(const std::string& name, std::string& contents) const -> bool;
+  void writeEntry(const std::string& name, const std::string& contents);
+  auto resultName(const CacheProbe& probe) const -> std::string;
+  auto readResult(const CacheProbe& probe, LintResult& result) const -> bool;
+  void storeIndex(const CacheProbe& probe);
+
+  std::string m_dir, m_cwd;
+  uint64_t    m_stamp{0};
+  bool        m_usable{false};
+
+  std::atomic<size_t> m_tempFiles{0};
+  std::atomic<size_t> m_statHits{0}, m_hashHits{0}, m_misses{0};
+};
+};  // namespace flint
@@ -4,11 +4,11 @@ using namespace std;
 
 namespace flint {
 
-auto formatArg(const vector<Token>& tokens, const Argument& arg) -> string {
+auto formatArg(const TokenList& tokens, const Argument& arg) -> string {
   string result;
 
   for (size_t pos = arg.first; pos < arg.last; ++pos) {
-    if (pos != arg.first && !(tokens[pos].precedingWhitespace_.empty())) result += ' ';
+    if (pos != arg.first && !(tokens.precedingWhitespace(pos).empty())) result += ' ';
 
     const auto& val = tokens[pos].value_;
     result.append(val.begin(), val.end());
@@ -16,7 +16,7 @@ auto formatArg(const vector<Token>& tokens, const Argument& arg) -> string {
   return result;
 };
 
-auto formatFunction(const vector<Token>& tokens, const Argument& func, const vector<Argument>& args) -> string {
+auto formatFunction(const TokenList& tokens, const Argument& func, const Arguments& args) -> string {
   static const string sep{", "};
 
   string result = formatArg(tokens, func) + '(';
@@ -29,8 +29,7 @@ auto formatFunction(const vector<Token>& tokens, const Argument& func, const vec
   return result;
 };
 
-auto getFunctionNameAndArguments(const vector<Token>& tokens, size_t& pos, Argument& func, vector<Argument>& args)
-    -> bool {
+auto getFunctionNameAndArguments(const TokenList& tokens, size_t& pos, Argument& func, Arguments& args) -> bool {
   func.first = pos;
   ++pos;
 
@@ -45,25 +44,23 @@ auto getFunctionNameAndArguments(const vector<Token>& tokens, size_t& pos, Argum
   return getRealArguments(tokens, pos, args);
 };
 
-auto getRealArguments(const vector<Token>& tokens, size_t& pos, vector<Argument>& args) -> bool {
+auto getRealArguments(const TokenList& tokens, size_t& pos, Arguments& args) -> bool {
   assert(isTok(tokens[pos], TK_LPAREN));
 
   ++pos;
-  size_t argStart   = pos;  // First arg starts after parenthesis
-  int    parenCount = 1;
+  size_t argStart = pos;  // First arg starts after parenthesis
 
   const size_t size = tokens.size();
   for (; pos < size && !isTok(tokens[pos], TK_EOF); ++pos) {
     const auto tok = tokens[pos].type_;
 
+    // Nested parentheses can't hold one of our commas, so hop over them
     if (tok == TK_LPAREN) {
-      ++parenCount;
-      continue;
-    }
-    if (tok == TK_RPAREN) {
-      if (--parenCount == 0) break;
+      pos = tokens.partner(pos);
+      if (isTok(tokens[pos], TK_EOF)) break;
       continue;
     }
+    if (tok == TK_RPAREN) break;
     /*
     if (tok == TK_LESS) {
             // This is a heuristic which would fail when < is used with
@@ -79,11 +76,9 @@ auto getRealArguments(const vector<Token>& tokens, size_t& pos, vector<Argument>
     }
     */
     if (tok == TK_COMMA) {
-      if (parenCount == 1) {
-        // end an argument of the function we are looking at
-        args.emplace_back(argStart, pos);
-        argStart = pos + 1;
-      }
+      // end an argument of the function we are looking at
+      args.emplace_back(argStart, pos);
+      argStart = pos + 1;
       continue;
     }
   }
@@ -94,10 +89,12 @@ auto getRealArguments(const vector<Token>& tokens, size_t& pos, vector<Argument>
   return true;
 };
 
-auto getIncludedPath(const StringFragment& path) -> string {
+auto getIncludedPath(const StringFragment& path) -> string { return to_string(getIncludedFragment(path)); };
+
+auto getIncludedFragment(const StringFragment& path) -> StringFragment {
   assert(*path.begin() == '<' or *path.begin() == '"');
   assert(path.back() == '>' or path.back() == '"');
-  return string(path.begin() + 1, path.end() - 1);
+  return StringFragment(path.begin() + 1, path.end() - 1);
 };
 
 auto matchAcrossTokens(const StringFragment& frag, TokenIter start, TokenIter end_iter) -> bool {
@@ -116,37 +113,19 @@ auto matchAcrossTokens(const StringFragment& frag, TokenIter start, TokenIter en
   return (f_pos == f_end);
 };
 
-auto readQualifiedIdentifier(const vector<Token>& tokens, size_t& pos) -> vector<StringFragment> {
-  vector<StringFragment> ret;
+void readQualifiedIdentifier(const TokenList& tokens, size_t& pos, QualifiedName& ident) {
+  ident.clear();
   for (; isTok(tokens[pos], TK_IDENTIFIER) || isTok(tokens[pos], TK_DOUBLE_COLON); ++pos)
-    if (isTok(tokens[pos], TK_IDENTIFIER)) ret.push_back(tokens[pos].value_);
-
-  return ret;
+    if (isTok(tokens[pos], TK_IDENTIFIER)) ident.push_back(tokens.symbol(pos));
 };
 
-auto skipBlock(const vector<Token>& tokens, size_t pos) -> size_t {
+auto skipBlock(const TokenList& tokens, size_t pos) -> size_t {
   assert(isTok(tokens[pos], TK_LCURL));
 
-  size_t openBraces = 1;  // Because we began on the leading '{'
-
-  ++pos;
-  for (const size_t size = tokens.size(); pos < size && !isTok(tokens[pos], TK_EOF); ++pos) {
-    const Token& tok = tokens[pos];
-
-    if (isTok(tok, TK_LCURL)) {
-      ++openBraces;
-      continue;
-    }
-    if (isTok(tok, TK_RCURL)) {
-      if (--openBraces == 0) break;
-      continue;
-    }
-  }
-
-  return pos;
+  return tokens.partner(pos);
 };
 
-auto skipFunctionDeclaration(const vector<Token>& tokens, size_t pos) -> size_t {
+auto skipFunctionDeclaration(const TokenList& tokens, size_t pos) -> size_t {
   for (const size_t size = tokens.size(); pos < size && !isTok(tokens[pos], TK_EOF); ++pos) {
     TokenType tok = tokens[pos].type_;
 
@@ -161,44 +140,19 @@ auto skipFunctionDeclaration(const vector<Token>& tokens, size_t pos) -> size_t
   return pos;
 };
 
-auto skipToToken(const vector<Token>& tokens, size_t& pos, TokenType target) -> bool {
+auto skipToToken(const TokenList& tokens, size_t& pos, TokenType target) -> bool {
   const size_t size = tokens.size();
-  for (; pos < size && !isTok(tokens[pos], target); ++pos) {}
-  return (pos < size && isTok(tokens[pos], target));
+  if (pos >= size) return false;
+  const auto found = static_cast<const uint8_t*>(memchr(tokens.types() + pos, target, size - pos));
+  pos              = found ? found - tokens.types() : size;
+  return found != nullptr;
 };
 
-auto skipTemplateSpec(const vector<Token>& tokens, size_t pos, bool* containsArray /* = nullptr */) -> size_t {
+auto skipTemplateSpec(const TokenList& tokens, size_t pos, bool* containsArray /* = nullptr */) -> size_t {
   assert(isTok(tokens[pos], TK_LESS));
 
-  size_t angleNest = 1;  // Because we began on the leading '<'
-  // Previous versions counted parens but commented out all usage
-
-  if (containsArray != nullptr) *containsArray = false;
-
-  ++pos;
-  for (const size_t size = tokens.size(); pos < size && !isTok(tokens[pos], TK_EOF); ++pos) {
-    const auto tok = tokens[pos].type_;
-
-    if (tok == TK_LPAREN) continue;
-    if (tok == TK_RPAREN) continue;
-
-    if (tok == TK_LSQUARE) {
-      if (angleNest == 1 && containsArray != nullptr) *containsArray = true;
-      continue;
-    }
-
-    if (tok == TK_LESS) {
-      ++angleNest;
-      continue;
-    }
-
-    if (tok == TK_GREATER) {
-      if (--angleNest == 0) return pos;
-      continue;
-    }
-  }
-
-  return pos;
+  if (containsArray != nullptr) *containsArray = tokens.templateHasArray(pos);
+  return tokens.partner(pos);
 };
 
 #if 0
@@ -215,7 +169,7 @@ auto skipTemplateSpec(const vector<Token>& tokens, size_t pos, bool* containsArr
  * @param tokens
  *        The token list for the file
  */
-void checkIncrementers(ErrorFile& errors, const string& path, const vector<Token>& tokens) {
+void checkIncrementers(ErrorFile& errors, const string& path, const TokenList& tokens) {
   const vector<TokenType> iteratorPlus  = {TK_IDENTIFIER, TK_INCREMENT};
   const vector<TokenType> iteratorMinus = {TK_IDENTIFIER, TK_DECREMENT};
 
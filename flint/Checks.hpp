@@ -3,6 +3,7 @@
 // There are a lot included here because this header is common across ALL checks
 #include <cassert>
 #include <iterator>
+#include <memory>
 #include <numeric>
 #include <stack>
 #include <string>
@@ -11,15 +12,39 @@
 #include <vector>
 
 #include "Checks.hpp"
+#include "Dispatcher.hpp"
 #include "ErrorReport.hpp"
 #include "FileCategories.hpp"
+#include "Scopes.hpp"
+#include "SmallVector.hpp"
 #include "Tokenizer.hpp"
 
 namespace flint {
 
 const std::string emptyString;
-struct Argument;  // Defined below
-using TokenIter = std::vector<Token>::const_iterator;
+using TokenIter = TokenList::const_iterator;
+
+/**
+ * Represent an argument or the name of a function.
+ * first is an iterator that points to the start of the argument.
+ * last is an iterator that points to the token right after the end of the
+ * argument.
+ */
+struct Argument {
+  size_t first;
+  size_t last;
+
+  inline Argument(size_t a, size_t b): first(a), last(b) {
+    // Just to check the port hasn't broken Token traversal somehow
+    assert(first <= last);
+  };
+};
+
+// The arguments of a function; few enough to stay off the heap
+using Arguments = SmallVector<Argument, 8>;
+
+// The symbols of a possibly namespace-qualified identifier
+using QualifiedName = SmallVector<Symbol, 4>;
 
 // ******************************* These are the helper functions for the checkers
 /*
@@ -61,16 +86,18 @@ void inline lint(ErrorFile&         errors,
 // Shorthand for comparing two strings (or fragments)
 template<class S, class T>
 inline auto cmpStr(const S& a, const T& b) -> bool {
-  auto const len_a = distance(a.begin(), a.end());
-  auto const len_b = distance(b.begin(), b.end());
-  if (len_a < len_b) return equal(a.begin(), a.end(), b.begin());
+  auto const len_a = std::distance(a.begin(), a.end());
+  auto const len_b = std::distance(b.begin(), b.end());
+  if (len_a < len_b) return std::equal(a.begin(), a.end(), b.begin());
   return equal(b.begin(), b.end(), a.begin());
 }
 inline auto cmpStr(const StringFragment& a, const StringFragment& b) -> bool { return (a == b); }
 // This version fails on OSX because it's SPECIAL:
 /* inline bool cmpStr(const StringFragment& a, const char* b) { return (a == StringFragment{b}); }
  */
-inline auto cmpStr(const StringFragment& a, const char* b) -> bool { return (to_string(a) == std::string{b}); }
+inline auto cmpStr(const StringFragment& a, const char* b) -> bool {
+  return a.size() == strlen(b) && std::equal(a.begin(), a.end(), b);
+}
 inline auto cmpStr(const std::string& a, const std::string& b) -> bool { return a == b; }
 inline auto cmpToks(const Token& a, const Token& b) -> bool { return cmpStr(a.value_, b.value_); };
 
@@ -92,11 +119,11 @@ inline auto isTok(const Token& token, TokenType type) -> bool { return token.typ
  * @return
  *        Returns true is the token at pos is a built-in type
  */
-inline auto atBuiltinType(const std::vector<Token>& tokens, size_t pos) -> bool {
+inline auto atBuiltinType(const TokenList& tokens, size_t pos) -> bool {
   static constexpr std::array<TokenType, 11> builtIns{
       TK_DOUBLE, TK_FLOAT, TK_INT, TK_SHORT, TK_UNSIGNED, TK_LONG, TK_SIGNED, TK_VOID, TK_BOOL, TK_WCHAR_T, TK_CHAR};
 
-  return std::find(std::begin(builtIns), std::end(builtIns), tokens[pos].type_) != std::end(builtIns);
+  return std::find(std::begin(builtIns), std::end(builtIns), tokens.type(pos)) != std::end(builtIns);
 };
 
 /**
@@ -112,9 +139,10 @@ inline auto atBuiltinType(const std::vector<Token>& tokens, size_t pos) -> bool
  *        Returns true if we were at the start of a given sequence
  */
 template<class Container>
-inline auto atSequence(const std::vector<Token>& tokens, size_t pos, const Container& list) -> bool {
-  return equal(std::begin(list), std::end(list), std::begin(tokens) + pos, [](TokenType type, const Token& token) {
-    return type == token.type_;
+inline auto atSequence(const TokenList& tokens, size_t pos, const Container& list) -> bool {
+  // Only the one-byte types need to be read
+  return std::equal(std::begin(list), std::end(list), tokens.types() + pos, [](TokenType type, uint8_t token) {
+    return type == token;
   });
 };
 
@@ -128,7 +156,7 @@ inline auto atSequence(const std::vector<Token>& tokens, size_t pos, const Conta
  * @return
  *        Returns a string representation of the argument token list
  */
-auto formatArg(const std::vector<Token>& tokens, const Argument& arg) -> std::string;
+auto formatArg(const TokenList& tokens, const Argument& arg) -> std::string;
 
 /**
  * Pretty print a function declaration/prototype to a string
@@ -142,8 +170,7 @@ auto formatArg(const std::vector<Token>& tokens, const Argument& arg) -> std::st
  * @return
  *        Returns a string representation of the argument token list
  */
-auto formatFunction(const std::vector<Token>& tokens, const Argument& func, const std::vector<Argument>& args)
-    -> std::string;
+auto formatFunction(const TokenList& tokens, const Argument& func, const Arguments& args) -> std::string;
 
 /**
  * No description available at this time!
@@ -170,10 +197,7 @@ inline auto getEndOfClass(TokenIter start, TokenIter maxPos) -> TokenIter {
  *        Returns true if we believe (sorta) that everything went okay,
  *        false if something bad happened (maybe)
  */
-auto getFunctionNameAndArguments(const std::vector<Token>& tokens,
-                                 size_t&                   pos,
-                                 Argument&                 func,
-                                 std::vector<Argument>&    args) -> bool;
+auto getFunctionNameAndArguments(const TokenList& tokens, size_t& pos, Argument& func, Arguments& args) -> bool;
 
 /**
  * Strips the ""'s or <>'s from an #include path
@@ -185,6 +209,16 @@ auto getFunctionNameAndArguments(const std::vector<Token>& tokens,
  */
 auto getIncludedPath(const StringFragment& path) -> std::string;
 
+/**
+ * Same as getIncludedPath, but points into the token instead of copying
+ *
+ * @param path
+ *        The string fragment to trim
+ * @return
+ *        Returns the include path without it's wrapping quotes/brackets
+ */
+auto getIncludedFragment(const StringFragment& path) -> StringFragment;
+
 /**
  * Get the list of arguments of a function, assuming that the current
  * iterator is at the open parenthesis of the function call. After the this
@@ -201,7 +235,7 @@ auto getIncludedPath(const StringFragment& path) -> std::string;
  *        Returns true if we believe (sorta) that everything went okay,
  *        false if something bad happened (maybe)
  */
-auto getRealArguments(const std::vector<Token>& tokens, size_t& pos, std::vector<Argument>& args) -> bool;
+auto getRealArguments(const TokenList& tokens, size_t& pos, Arguments& args) -> bool;
 
 /**
  * No description available at this time!
@@ -216,11 +250,12 @@ auto matchAcrossTokens(const StringFragment& frag, TokenIter start, TokenIter en
  *        The token list for the file
  * @param pos
  *        The current index position inside the token list
- * @return
- *        Returns a vector of all the identifier values involved, or an
- *        empty vector if no identifier was detected.
+ * @param ident
+ *        Filled with the symbols of all the identifiers involved (SYM_NONE
+ *        for those the checks don't look for), or left empty if no
+ *        identifier was detected
  */
-auto readQualifiedIdentifier(const std::vector<Token>& tokens, size_t& pos) -> std::vector<StringFragment>;
+void readQualifiedIdentifier(const TokenList& tokens, size_t& pos, QualifiedName& ident);
 
 /**
  * Traverses the token list until the whole code block has been passed
@@ -232,7 +267,7 @@ auto readQualifiedIdentifier(const std::vector<Token>& tokens, size_t& pos) -> s
  * @return
  *        Returns the position of the closing curly bracket
  */
-auto skipBlock(const std::vector<Token>& tokens, size_t pos) -> size_t;
+auto skipBlock(const TokenList& tokens, size_t pos) -> size_t;
 
 /**
  * Starting from a function name or one of its arguments, skips the entire
@@ -248,7 +283,7 @@ auto skipBlock(const std::vector<Token>& tokens, size_t pos) -> size_t;
  * @return
  *        Returns the position of the closing curly bracket or semicolon
  */
-auto skipFunctionDeclaration(const std::vector<Token>& tokens, size_t pos) -> size_t;
+auto skipFunctionDeclaration(const TokenList& tokens, size_t pos) -> size_t;
 
 /**
  * Moves pos to the next position of the target token
@@ -262,7 +297,7 @@ auto skipFunctionDeclaration(const std::vector<Token>& tokens, size_t pos) -> si
  * @return
  *        Returns true if we are at the given token
  */
-auto skipToToken(const std::vector<Token>& tokens, size_t& pos, TokenType target) -> bool;
+auto skipToToken(const TokenList& tokens, size_t& pos, TokenType target) -> bool;
 
 /**
  * Traverses the token list until the whole template sequence has been passed
@@ -277,41 +312,39 @@ auto skipToToken(const std::vector<Token>& tokens, size_t& pos, TokenType target
  * @return
  *        Returns the position of the closing angle bracket
  */
-auto skipTemplateSpec(const std::vector<Token>& tokens, size_t pos, bool* containsArray = nullptr) -> size_t;
+auto skipTemplateSpec(const TokenList& tokens, size_t pos, bool* containsArray = nullptr) -> size_t;
 
 // ******************************* End of helper functions for the checkers
 
+/*
+ * Which files a check applies to, for the registry (see Registry.hpp) to
+ * plan the checks of each file category once, at startup. Every check
+ * defines its own as traits<Name>, next to its code.
+ */
+struct CheckTraits {
+  Lint     level;       // Of its most severe reports; it only runs if --level shows them
+  bool     cppOnly;     // Left out with --cmode
+  unsigned categories;  // The categoryBit()s of the files it looks at
+};
+
 // Bring in all the checks from the two directories...
 
-// Most checks get just the tokenized file
-#define X(func) void check##func(ErrorFile& errors, const std::string& path, const std::vector<Token>& tokens)
+// Most checks visit the tokens they want during a sweep shared with the others
+#define X(func)                                            \
+  auto make##func##Check() -> std::unique_ptr<TokenCheck>; \
+  extern const CheckTraits traits##func
 
-// More advanced checks get access to a list of identified structs/classes/unions
-#define X_struct(func)                                \
-  void check##func(ErrorFile&                 errors, \
-                   const std::string&         path,   \
-                   const std::vector<Token>&  tokens, \
-                   const std::vector<size_t>& structures)
+// More advanced checks get access to the scopes of the file: namespaces, structs/classes/unions, ...
+#define X_struct(func)                         \
+  void check##func(ErrorFile&         errors,  \
+                   const std::string& path,    \
+                   const TokenList&   tokens,  \
+                   const ScopeTree&   scopes); \
+  extern const CheckTraits traits##func
 
 // Makefile automatically regenerates this when you do "make clean"
 #include "Checks.inc"
 
 #undef X_struct
 #undef X
-
-/**
- * Represent an argument or the name of a function.
- * first is an iterator that points to the start of the argument.
- * last is an iterator that points to the token right after the end of the
- * argument.
- */
-struct Argument {
-  size_t first;
-  size_t last;
-
-  inline Argument(size_t a, size_t b): first(a), last(b) {
-    // Just to check the port hasn't broken Token traversal somehow
-    assert(first <= last);
-  };
-};
 }  // namespace flint
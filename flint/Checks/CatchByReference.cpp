@@ -3,6 +3,7 @@ using namespace std;
 
 namespace flint {
 
+namespace {
 /**
  * Only the following forms of catch are allowed:
  *
@@ -15,17 +16,13 @@ namespace flint {
  *
  * Type cannot be built-in; this function enforces that it's
  * user-defined.
- *
- * @param errors
- *        Struct to track how many errors/warnings/advice occured
- * @param path
- *        The path to the file currently being linted
- * @param tokens
- *        The token list for the file
  */
-void checkCatchByReference(ErrorFile& errors, const string& path, const vector<Token>& tokens) {
-  for (size_t pos = 0, size = tokens.size(); pos < size; ++pos) {
-    if (!isTok(tokens[pos], TK_CATCH)) continue;
+class CatchByReference: public TokenCheck {
+ public:
+  CatchByReference(): TokenCheck({TK_CATCH}){};
+
+  auto visit(ErrorFile& errors, const string& path, const TokenList& tokens, size_t pos) -> size_t override {
+    const size_t size = tokens.size();
 
     size_t focal = pos + 1;
     if (!isTok(tokens[focal], TK_LPAREN)) {  // a "(" comes always after catch
@@ -36,7 +33,7 @@ void checkCatchByReference(ErrorFile& errors, const string& path, const vector<T
 
     if (isTok(tokens[focal], TK_ELLIPSIS))
       // catch (...
-      continue;
+      return pos + 1;
     if (isTok(tokens[focal], TK_CONST))
       // catch (const
       ++focal;
@@ -56,7 +53,7 @@ void checkCatchByReference(ErrorFile& errors, const string& path, const vector<T
                   tok,
                   "Symbol '" + to_string(tok.value_) +
                       "' invalid in catch clause. You may only catch user-defined types.");
-      continue;
+      return pos + 1;
     }
     ++focal;
 
@@ -83,10 +80,10 @@ void checkCatchByReference(ErrorFile& errors, const string& path, const vector<T
     // anonymous identifier.
     if (isTok(tokens[focal - 1], TK_AMPERSAND))
       // check! catch (whatever &)
-      continue;
+      return pos + 1;
     if (isTok(tokens[focal - 1], TK_IDENTIFIER) && isTok(tokens[focal - 2], TK_AMPERSAND))
       // check! catch (whatever & ident)
-      continue;
+      return pos + 1;
 
     // Oopsies times
     const Token& tok = tokens[focal - 1];
@@ -101,6 +98,14 @@ void checkCatchByReference(ErrorFile& errors, const string& path, const vector<T
               tok,
               "Symbol '" + to_string(tok.value_) + "' of type '" + theType +
                   "' caught by value. Use catch by (preferably const) reference throughout.");
-  }
+    return pos + 1;
+  };
 };
+};  // namespace
+
+auto makeCatchByReferenceCheck() -> unique_ptr<TokenCheck> {
+  return unique_ptr<TokenCheck>(new CatchByReference);
+};
+
+const CheckTraits traitsCatchByReference{Lint::ERROR, true, ALL_FILE_CATEGORIES};
 }  // namespace flint
@@ -3,30 +3,27 @@ using namespace std;
 
 namespace flint {
 
+namespace {
 /**
  * If encounter memset(foo, sizeof(foo), 0), we warn that the order
  * of the arguments is wrong.
  * Known unsupported case: calling memset inside another memset. The inner
  * call will not be checked.
- *
- * @param errors
- *        Struct to track how many errors/warnings/advice occured
- * @param path
- *        The path to the file currently being linted
- * @param tokens
- *        The token list for the file
  */
-void checkMemset(ErrorFile& errors, const string& path, const vector<Token>& tokens) {
-  static constexpr array<TokenType, 2> funcSequence = {TK_IDENTIFIER, TK_LPAREN};
+class Memset: public TokenCheck {
+ public:
+  Memset(): TokenCheck({TK_IDENTIFIER}, {SYM_MEMSET}){};
 
-  for (size_t pos = 0, size = tokens.size(); pos < size; ++pos) {
-    const auto tok = tokens[pos];
+  auto visit(ErrorFile& errors, const string& path, const TokenList& tokens, size_t pos) -> size_t override {
+    static constexpr array<TokenType, 2> funcSequence = {TK_IDENTIFIER, TK_LPAREN};
+
+    if (tokens.symbol(pos) != SYM_MEMSET || !atSequence(tokens, pos, funcSequence)) return pos + 1;
 
-    if (!atSequence(tokens, pos, funcSequence) || !cmpTok(tok, "memset")) continue;
+    const auto tok = tokens[pos];
 
-    vector<Argument> args;
-    Argument         func(pos, pos);
-    if (!getFunctionNameAndArguments(tokens, pos, func, args)) return;
+    Arguments args;
+    Argument  func(pos, pos);
+    if (!getFunctionNameAndArguments(tokens, pos, func, args)) return tokens.size();
 
     // If there are more than 3 arguments, then there might be something wrong
     // with skipTemplateSpec but the iterator didn't reach the EOF (because of
@@ -36,13 +33,21 @@ void checkMemset(ErrorFile& errors, const string& path, const vector<Token>& tok
       // wrong calls include memset(..., ..., 0) and memset(..., sizeof..., 1)
       const bool error = ((args[2].last - args[2].first) == 1) &&
                          (cmpTok(tokens[args[2].first], "0") ||
-                          (cmpTok(tokens[args[2].first], "1") && cmpTok(tokens[args[1].first], "sizeof")));
+                          (cmpTok(tokens[args[2].first], "1") && isTok(tokens[args[1].first], TK_SIZEOF)));
 
-      if (!error) continue;
+      if (!error) return pos + 1;
 
       swap(args[1], args[2]);
       lintError(errors, tok, "Did you mean " + formatFunction(tokens, func, args) + " ?");
     }
-  }
+    return pos + 1;
+  };
 };
+};  // namespace
+
+auto makeMemsetCheck() -> unique_ptr<TokenCheck> {
+  return unique_ptr<TokenCheck>(new Memset);
+};
+
+const CheckTraits traitsMemset{Lint::ERROR, false, ALL_FILE_CATEGORIES};
 }  // namespace flint
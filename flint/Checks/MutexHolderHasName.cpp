@@ -3,29 +3,22 @@ using namespace std;
 
 namespace flint {
 
+namespace {
 /**
  * Disallow the declaration of mutex holders
  * with no name, since that causes the destructor to be called
  * on the same line, releasing the lock immediately.
- *
- * @param errors
- *        Struct to track how many errors/warnings/advice occured
- * @param path
- *        The path to the file currently being linted
- * @param tokens
- *        The token list for the file
  */
-void checkMutexHolderHasName(ErrorFile& errors, const string& path, const vector<Token>& tokens) {
-  if (getFileCategory(path) == FileCategory::SOURCE_C) return;
+class MutexHolderHasName: public TokenCheck {
+ public:
+  MutexHolderHasName(): TokenCheck({TK_IDENTIFIER}, {SYM_LOCK_GUARD}){};
 
-  static const string mutexHolder{"lock_guard"};
+  auto visit(ErrorFile& errors, const string& path, const TokenList& tokens, size_t pos) -> size_t override {
+    static constexpr array<TokenType, 2> mutexSequence{TK_IDENTIFIER, TK_LESS};
 
-  static constexpr array<TokenType, 2> mutexSequence{TK_IDENTIFIER, TK_LESS};
+    static constexpr array<TokenType, 2> mutexConstructor{TK_GREATER, TK_LPAREN};
 
-  static constexpr array<TokenType, 2> mutexConstructor{TK_GREATER, TK_LPAREN};
-
-  for (size_t pos = 0, size = tokens.size(); pos < size - 1; ++pos) {
-    if (atSequence(tokens, pos, mutexSequence) && cmpTok(tokens[pos], mutexHolder)) {
+    if (tokens.symbol(pos) == SYM_LOCK_GUARD && atSequence(tokens, pos, mutexSequence)) {
       pos = skipTemplateSpec(tokens, ++pos);
       if (atSequence(tokens, pos, mutexConstructor))
         lintError(errors,
@@ -33,6 +26,14 @@ void checkMutexHolderHasName(ErrorFile& errors, const string& path, const vector
                   "Mutex holder variable declared without a name, "
                   "causing the lock to be released immediately.");
     }
-  }
+    return pos + 1;
+  };
+};
+};  // namespace
+
+auto makeMutexHolderHasNameCheck() -> unique_ptr<TokenCheck> {
+  return unique_ptr<TokenCheck>(new MutexHolderHasName);
 };
+
+const CheckTraits traitsMutexHolderHasName{Lint::ERROR, true, ALL_FILE_CATEGORIES & ~categoryBit(SOURCE_C)};
 }  // namespace flint
@@ -3,6 +3,7 @@ using namespace std;
 
 namespace flint {
 
+namespace {
 /**
  * Identifies usage of shared_ptr() and suggests replacing with
  * make_shared(). When shared_ptr takes 3 arguments, a custom allocator is used
@@ -19,43 +20,39 @@ namespace flint {
  * <namespace>::shared_ptr TemplateSpc identifier Arguments
  * where the first argument starts with "new" and <namespace> is optional
  * and, when present, one of the values described above.
- *
- * @param errors
- *        Struct to track how many errors/warnings/advice occured
- * @param path
- *        The path to the file currently being linted
- * @param tokens
- *        The token list for the file
  */
-void checkSmartPtrUsage(ErrorFile& errors, const string& path, const vector<Token>& tokens) {
-  static constexpr array<TokenType, 2> funcSignature{TK_IDENTIFIER, TK_LPAREN};
+class SmartPtrUsage: public TokenCheck {
+ public:
+  SmartPtrUsage(): TokenCheck({TK_IDENTIFIER, TK_DOUBLE_COLON}, {SYM_SHARED_PTR}){};
+
+  auto visit(ErrorFile& errors, const string& path, const TokenList& tokens, size_t pos) -> size_t override {
+    static constexpr array<TokenType, 2> funcSignature{TK_IDENTIFIER, TK_LPAREN};
 
-  for (size_t pos = 0, size = tokens.size(); pos < size - 1; ++pos) {
-    const auto ident = readQualifiedIdentifier(tokens, pos);
+    QualifiedName ident;
+    readQualifiedIdentifier(tokens, pos, ident);
 
-    if (!((ident.size() == 1 && cmpStr(ident[0], "shared_ptr")) ||
-          (ident.size() == 2 && (cmpStr(ident[0], "std") || cmpStr(ident[0], "boost")) &&
-           cmpStr(ident[1], "shared_ptr"))))
-      continue;
+    if (!((ident.size() == 1 && ident[0] == SYM_SHARED_PTR) ||
+          (ident.size() == 2 && (ident[0] == SYM_STD || ident[0] == SYM_BOOST) && ident[1] == SYM_SHARED_PTR)))
+      return pos + 1;
 
     // Stash indices for later
     size_t       i           = pos;
     const size_t sharedPtrIt = pos;
 
     // Determine if the template parameter is an array type.
-    if (!isTok(tokens[i], TK_LESS)) continue;
+    if (!isTok(tokens[i], TK_LESS)) return pos + 1;
     i = skipTemplateSpec(tokens, i);
-    if (isTok(tokens[i], TK_EOF)) return;
+    if (isTok(tokens[i], TK_EOF)) return tokens.size();
     assert(isTok(tokens[i], TK_GREATER));
     ++i;
 
     // look for a possible function call
-    if (!atSequence(tokens, i, funcSignature)) continue;
+    if (!atSequence(tokens, i, funcSignature)) return pos + 1;
 
     ++i;
-    vector<Argument> args;
+    Arguments args;
     // ensure the function call first argument is a new expression
-    if (!getRealArguments(tokens, i, args)) continue;
+    if (!getRealArguments(tokens, i, args)) return pos + 1;
 
     if (isTok(tokens[i], TK_RPAREN) && isTok(tokens[i + 1], TK_SEMICOLON) && (args.size() > 0) &&
         (isTok(tokens[(args[0].first)], TK_NEW))) {
@@ -67,6 +64,14 @@ void checkSmartPtrUsage(ErrorFile& errors, const string& path, const vector<Toke
       lintWarning(
           errors, tokens[sharedPtrIt], "Consider using '" + newFn + "' which performs better with fewer allocations.");
     }
-  }
+    return pos + 1;
+  };
 };
+};  // namespace
+
+auto makeSmartPtrUsageCheck() -> unique_ptr<TokenCheck> {
+  return unique_ptr<TokenCheck>(new SmartPtrUsage);
+};
+
+const CheckTraits traitsSmartPtrUsage{Lint::WARNING, true, ALL_FILE_CATEGORIES};
 }  // namespace flint
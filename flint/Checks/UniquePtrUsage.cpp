@@ -3,36 +3,36 @@ using namespace std;
 
 namespace flint {
 
+namespace {
 /**
  * Identifies incorrect usage of unique_ptr() with arrays. In other
  * words the unique_ptr is used with an array allocation, but not declared as
  * an array. The canonical example is: unique_ptr<Foo> Bar(new Foo[8]), which
  * compiles fine but should be unique_ptr<Foo[]> Bar(new Foo[8]).
- *
- * @param errors
- *        Struct to track how many errors/warnings/advice occured
- * @param path
- *        The path to the file currently being linted
- * @param tokens
- *        The token list for the file
  */
-void checkUniquePtrUsage(ErrorFile& errors, const string& path, const vector<Token>& tokens) {
-  for (size_t pos = 0, size = tokens.size(); pos < size - 1; ++pos) {
-    const auto ident = readQualifiedIdentifier(tokens, pos);
+class UniquePtrUsage: public TokenCheck {
+ public:
+  UniquePtrUsage(): TokenCheck({TK_IDENTIFIER, TK_DOUBLE_COLON}, {SYM_UNIQUE_PTR}){};
 
-    if (!((ident.size() == 1 && cmpStr(ident[0], "unique_ptr")) ||
-          (ident.size() == 2 && cmpStr(ident[0], "std") && cmpStr(ident[1], "unique_ptr"))))
-      continue;
+  auto visit(ErrorFile& errors, const string& path, const TokenList& tokens, size_t pos) -> size_t override {
+    const size_t size = tokens.size();
+
+    QualifiedName ident;
+    readQualifiedIdentifier(tokens, pos, ident);
+
+    if (!((ident.size() == 1 && ident[0] == SYM_UNIQUE_PTR) ||
+          (ident.size() == 2 && ident[0] == SYM_STD && ident[1] == SYM_UNIQUE_PTR)))
+      return pos + 1;
 
     // Stash indices for later
     size_t       i           = pos;
     const size_t uniquePtrIt = pos;
 
     // Determine if the template parameter is an array type.
-    if (!isTok(tokens[i], TK_LESS)) continue;
+    if (!isTok(tokens[i], TK_LESS)) return pos + 1;
     bool uniquePtrHasArray = false;
     i                      = skipTemplateSpec(tokens, i, &uniquePtrHasArray);
-    if (isTok(tokens[i], TK_EOF)) return;
+    if (isTok(tokens[i], TK_EOF)) return tokens.size();
     assert(isTok(tokens[i], TK_GREATER));
     ++i;
 
@@ -45,7 +45,7 @@ void checkUniquePtrUsage(ErrorFile& errors, const string& path, const vector<Tok
      * new-expression in the argument declarations.
      */
     if (isTok(tokens[i], TK_IDENTIFIER)) ++i;
-    if (!isTok(tokens[i], TK_LPAREN)) continue;  // Bail
+    if (!isTok(tokens[i], TK_LPAREN)) return pos + 1;  // Bail
     ++i;
 
     size_t parenNest = 1;
@@ -68,7 +68,7 @@ void checkUniquePtrUsage(ErrorFile& errors, const string& path, const vector<Tok
       while (isTok(tokens[i], TK_IDENTIFIER) || isTok(tokens[i], TK_DOUBLE_COLON)) ++i;
       if (isTok(tokens[i], TK_LESS)) {
         i = skipTemplateSpec(tokens, i);
-        if (i == (size - 1)) return;
+        if (i == (size - 1)) return tokens.size();
         ++i;
       } else {
         while (atBuiltinType(tokens, i)) ++i;
@@ -82,6 +82,14 @@ void checkUniquePtrUsage(ErrorFile& errors, const string& path, const vector<Tok
                                      : "unique_ptr<T> should be unique_ptr<T[]> when used with an array."));
       break;
     }
-  }
+    return pos + 1;
+  };
 };
+};  // namespace
+
+auto makeUniquePtrUsageCheck() -> unique_ptr<TokenCheck> {
+  return unique_ptr<TokenCheck>(new UniquePtrUsage);
+};
+
+const CheckTraits traitsUniquePtrUsage{Lint::ERROR, true, ALL_FILE_CATEGORIES};
 }  // namespace flint
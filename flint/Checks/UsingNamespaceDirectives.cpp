@@ -3,64 +3,73 @@ using namespace std;
 
 namespace flint {
 
+namespace {
 /**
  * Check for conflicting namespace usages
- *
- * @param errors
- *        Struct to track how many errors/warnings/advice occured
- * @param path
- *        The path to the file currently being linted
- * @param tokens
- *        The token list for the file
  */
-void checkUsingNamespaceDirectives(ErrorFile& errors, const string& path, const vector<Token>& tokens) {
-  vector<StringFragment> namespaces;
-  stack<size_t>          scopes;
+class UsingNamespaceDirectives: public TokenCheck {
+ public:
+  UsingNamespaceDirectives(): TokenCheck({TK_LCURL, TK_RCURL, TK_USING}){};
 
-  static constexpr array<TokenType, 2> usingNamespace{TK_USING, TK_NAMESPACE};
+  auto start(ErrorFile& errors, const string& path, const TokenList& tokens) -> bool override {
+    m_namespaces.clear();
+    m_scopes.clear();
+    return true;
+  };
 
-  static const array<string, 6> exclusive{"std", "std::tr1", "boost", "::std", "::std::tr1", "::boost"};
+  auto visit(ErrorFile& errors, const string& path, const TokenList& tokens, size_t pos) -> size_t override {
+    static constexpr array<TokenType, 2> usingNamespace{TK_USING, TK_NAMESPACE};
 
-  static const vector<StringFragment> exclusiveFragments = []() -> vector<StringFragment> {
-    vector<StringFragment> out;
-    for_each(begin(exclusive), end(exclusive), [&](const string& str) { out.emplace_back(begin(str), end(str)); });
-    return out;
-  }();
+    static const array<string, 6> exclusive{"std", "std::tr1", "boost", "::std", "::std::tr1", "::boost"};
+
+    static const vector<StringFragment> exclusiveFragments = []() -> vector<StringFragment> {
+      vector<StringFragment> out;
+      for_each(begin(exclusive), end(exclusive), [&](const string& str) { out.emplace_back(str); });
+      return out;
+    }();
 
-  for (size_t pos = 0, size = tokens.size(); pos < size; ++pos) {
     if (isTok(tokens[pos], TK_LCURL)) {
-      scopes.push(namespaces.size());
-      continue;
+      m_scopes.push_back(m_namespaces.size());
+      return pos + 1;
     }
 
     if (isTok(tokens[pos], TK_RCURL)) {
-      if (!scopes.empty()) {
-        auto del = scopes.top();
-        while (namespaces.size() > del) namespaces.pop_back();
-        scopes.pop();
+      if (!m_scopes.empty()) {
+        auto del = m_scopes.back();
+        while (m_namespaces.size() > del) m_namespaces.pop_back();
+        m_scopes.pop_back();
       }
-      continue;
+      return pos + 1;
     }
 
-    if (atSequence(tokens, pos, usingNamespace)) {
-      pos += 2;
+    if (!atSequence(tokens, pos, usingNamespace)) return pos + 1;
+    pos += 2;
 
-      const auto isExclusive =
-          find_if(begin(exclusiveFragments), end(exclusiveFragments), [=](const StringFragment& frag) {
-            return matchAcrossTokens(frag, begin(tokens) + pos, end(tokens));
-          });
-      if (isExclusive == end(exclusiveFragments)) continue;
+    const auto isExclusive =
+        find_if(begin(exclusiveFragments), end(exclusiveFragments), [&](const StringFragment& frag) {
+          return matchAcrossTokens(frag, begin(tokens) + pos, end(tokens));
+        });
+    if (isExclusive == end(exclusiveFragments)) return pos + 1;
 
-      const auto conflict = find_if(
-          begin(namespaces), end(namespaces), [&](const StringFragment& frag) { return !(frag == *isExclusive); });
-      if (conflict != end(namespaces))
-        lintWarning(
-            errors, tokens[pos], "Conflicting namespaces: " + to_string(*isExclusive) + " and " + to_string(*conflict));
+    const auto conflict = find_if(
+        begin(m_namespaces), end(m_namespaces), [&](const StringFragment& frag) { return !(frag == *isExclusive); });
+    if (conflict != end(m_namespaces))
+      lintWarning(
+          errors, tokens[pos], "Conflicting namespaces: " + to_string(*isExclusive) + " and " + to_string(*conflict));
 
-      namespaces.push_back(*isExclusive);
-      continue;
-    }
-  }
+    m_namespaces.push_back(*isExclusive);
+    return pos + 1;
+  };
+
+ private:
+  vector<StringFragment> m_namespaces;
+  vector<size_t>         m_scopes;  // How many namespaces were in use as each open block began
+};
+};  // namespace
+
+auto makeUsingNamespaceDirectivesCheck() -> unique_ptr<TokenCheck> {
+  return unique_ptr<TokenCheck>(new UsingNamespaceDirectives);
 };
 
+const CheckTraits traitsUsingNamespaceDirectives{Lint::WARNING, false, ALL_FILE_CATEGORIES};
 }  // namespace flint
@@ -0,0 +1,225 @@
+#include "Config.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+
+#include "ErrorReport.hpp"
+#include "Json.hpp"
+#include "Polyfill.hpp"
+
+using namespace std;
+
+namespace flint {
+
+LintConfig Config;
+
+namespace {
+/**
+ * Reads a token sequence written as code, such as "asm volatile"
+ *
+ * @param text
+ *        The code
+ * @param sequence
+ *        Filled with the types of its tokens
+ * @return
+ *        Returns false if the text holds no tokens or can't be tokenized
+ */
+auto readSequence(const string& text, SequenceMatcher::Sequence& sequence) -> bool {
+  static const string name{"config"};
+
+  TokenList tokens;
+  ErrorFile errors(name);
+  try {
+    tokenize(text, name, tokens, errors);
+  } catch (const exception&) {
+    return false;
+  }
+
+  // Leave out the EOF token
+  sequence.clear();
+  for (size_t pos = 0; pos + 1 < tokens.size(); ++pos) sequence.push_back(tokens.type(pos));
+  return !sequence.empty();
+};
+
+/**
+ * @return
+ *        Returns whether the value is a string, setting level to the Lint
+ *        level it names
+ */
+auto readLevel(const JsonValue& value, Lint& level) -> bool {
+  if (value.type != JsonValue::STRING) return false;
+  if (value.text == "error")
+    level = Lint::ERROR;
+  else if (value.text == "warning")
+    level = Lint::WARNING;
+  else if (value.text == "advice")
+    level = Lint::ADVICE;
+  else
+    return false;
+  return true;
+};
+
+/**
+ * @return
+ *        Returns the member of an object if it is a string, else nullptr
+ */
+auto findString(const JsonValue& object, const string& key) -> const string* {
+  const JsonValue* found = object.find(key);
+  return (found && found->type == JsonValue::STRING) ? &found->text : nullptr;
+};
+};  // namespace
+
+void PathTrie::insert(const string& path) {
+  uint32_t node = 0;
+  for (const char c: path) {
+    auto& children = m_nodes[node].children;
+    auto  child    = children.begin();
+    while (child != children.end() && child->first != c) ++child;
+    if (child != children.end()) {
+      node = child->second;
+      continue;
+    }
+    const auto added = static_cast<uint32_t>(m_nodes.size());
+    children.emplace_back(c, added);
+    m_nodes.emplace_back();
+    node = added;
+  }
+
+  if (!path.empty() && path.back() == '/')
+    m_nodes[node].directory = true;
+  else
+    m_nodes[node].path = true;
+};
+
+auto PathTrie::contains(const StringFragment& path) const -> bool {
+  uint32_t node = 0;
+  for (const char c: path) {
+    const auto& children = m_nodes[node].children;
+    auto        child    = children.begin();
+    while (child != children.end() && child->first != c) ++child;
+    if (child == children.end()) return false;
+
+    node = child->second;
+    if (m_nodes[node].directory) return true;
+  }
+  return m_nodes[node].path;
+};
+
+LintConfig::LintConfig(): m_matcher(vector<SequenceMatcher::Sequence>{}) {
+  banIdentifier(SYM_STRTOK, Lint::ERROR, "'strtok' is not thread safe. Consider 'strtok_r'.");
+  banIdentifier(SYM_NULL, Lint::ADVICE, "Prefer `nullptr' to `NULL' in new C++ code.");
+
+  m_sequences.push_back(
+      {{TK_VOLATILE},
+       "'volatile' is not thread-safe.",
+       "If multiple threads are sharing data, use std::atomic or locks. In addition, 'volatile' may "
+       "force the compiler to generate worse code than it could otherwise. "
+       "For more about why 'volatile' doesn't do what you think it does, see "
+       "http://www.kernel.org/doc/Documentation/volatile-considered-harmful.txt.",
+       true});
+  m_allowed.push_back({TK_ASM, TK_VOLATILE});
+  compileSequences();
+
+  // The deprecated includes. Add new headers here, or in a config file,
+  // if you'd like to deprecate them
+  m_includes.insert("common/base/Base.h");
+  m_includes.insert("common/base/StringUtil.h");
+};
+
+auto LintConfig::load(const string& path) -> bool {
+  FileBuffer contents;
+  if (!contents.load(path)) {
+    fprintf(stderr, "Cannot read config file '%s'.\n\n", path.c_str());
+    return false;
+  }
+  m_source.assign(contents.begin(), contents.end());
+
+  JsonValue config;
+  string    error;
+  if (!parseJson(contents.begin(), contents.end(), config, error)) {
+    fprintf(stderr, "Cannot parse config file '%s': %s.\n\n", path.c_str(), error.c_str());
+    return false;
+  }
+
+  const auto invalid = [&path](const string& what) {
+    fprintf(stderr, "Invalid config file '%s': %s.\n\n", path.c_str(), what.c_str());
+    return false;
+  };
+  if (config.type != JsonValue::OBJECT) return invalid("not an object");
+
+  SequenceMatcher::Sequence sequence;
+  for (const auto& member: config.object) {
+    const string&    key  = member.first;
+    const JsonValue& list = member.second;
+    if (list.type != JsonValue::ARRAY) return invalid("'" + key + "' is not an array");
+
+    if (key == "bannedIdentifiers") {
+      for (const JsonValue& entry: list.array) {
+        const string* name    = findString(entry, "name");
+        const string* message = findString(entry, "message");
+        if (!name || !message) return invalid("banned identifiers need a name and a message");
+
+        // Keywords have token types of their own
+        if (!readSequence(*name, sequence) || sequence.size() != 1 || sequence[0] != TK_IDENTIFIER)
+          return invalid("'" + *name + "' is not an identifier; ban keywords with bannedSequences");
+
+        Lint             level = Lint::ERROR;
+        const JsonValue* named = entry.find("level");
+        if (named && !readLevel(*named, level)) return invalid("levels are \"error\", \"warning\" or \"advice\"");
+
+        banIdentifier(Symbols.intern(*name), level, *message);
+      }
+    } else if (key == "bannedSequences") {
+      for (const JsonValue& entry: list.array) {
+        const string* tokens      = findString(entry, "tokens");
+        const string* title       = findString(entry, "title");
+        const string* description = findString(entry, "description");
+        if (!tokens || !title) return invalid("banned sequences need tokens and a title");
+        if (!readSequence(*tokens, sequence)) return invalid("cannot read the tokens '" + *tokens + "'");
+
+        const JsonValue* cppOnly = entry.find("cppOnly");
+        if (cppOnly && cppOnly->type != JsonValue::BOOL) return invalid("cppOnly is true or false");
+
+        m_sequences.push_back({sequence, *title, description ? *description : "", cppOnly && cppOnly->boolean});
+      }
+    } else if (key == "allowedSequences") {
+      for (const JsonValue& entry: list.array) {
+        if (entry.type != JsonValue::STRING || !readSequence(entry.text, sequence))
+          return invalid("allowed sequences are strings of tokens");
+        m_allowed.push_back(sequence);
+      }
+    } else if (key == "deprecatedIncludes") {
+      for (const JsonValue& entry: list.array) {
+        if (entry.type != JsonValue::STRING || entry.text.empty())
+          return invalid("deprecated includes are paths, or directories ending with '/'");
+        m_includes.insert(entry.text);
+      }
+    } else {
+      return invalid("unknown list '" + key + "'");
+    }
+  }
+
+  compileSequences();
+  return true;
+};
+
+void LintConfig::banIdentifier(Symbol symbol, Lint level, string message) {
+  if (symbol >= m_identifierAt.size()) m_identifierAt.resize(symbol + 1, 0);
+
+  // A later entry replaces an earlier one
+  if (m_identifierAt[symbol] != 0) {
+    m_identifiers[m_identifierAt[symbol] - 1] = {level, move(message)};
+    return;
+  }
+  m_identifiers.push_back({level, move(message)});
+  m_identifierAt[symbol] = static_cast<uint32_t>(m_identifiers.size());
+  m_symbolBits |= TokenList::symbolBit(symbol);
+};
+
+void LintConfig::compileSequences() {
+  vector<SequenceMatcher::Sequence> sequences;
+  for (const BannedSequence& banned: m_sequences) sequences.push_back(banned.tokens);
+  sequences.insert(sequences.end(), m_allowed.begin(), m_allowed.end());
+  m_matcher = SequenceMatcher(sequences);
+};
+};  // namespace flint
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Options.hpp"
+#include "SequenceMatcher.hpp"
+#include "Symbols.hpp"
+#include "Tokenizer.hpp"
+
+namespace flint {
+
+struct BannedIdentifier {
+  Lint        level;
+  std::string message;
+};
+
+struct BannedSequence {
+  std::vector<TokenType> tokens;
+  std::string            title;
+  std::string            description;
+  bool                   cppOnly;
+};
+
+/*
+ * Paths, and directories of paths, looked up one character at a time
+ */
+class PathTrie {
+ public:
+  /**
+   * @param path
+   *        A path, or a directory ending with '/' standing for every path
+   *        under it
+   */
+  void insert(const std::string& path);
+
+  /**
+   * @return
+   *        Returns whether the path, or a directory holding it, was inserted
+   */
+  auto contains(const StringFragment& path) const -> bool;
+
+ private:
+  struct Node {
+    std::vector<std::pair<char, uint32_t>> children;
+    bool                                   path      = false;
+    bool                                   directory = false;
+  };
+
+  std::vector<Node> m_nodes{1};  // m_nodes[0] is the empty path
+};
+
+/*
+ * The identifiers, token sequences and includes the checks report, built
+ * in and from the --config file
+ *
+ * Loaded once at startup, before any file is tokenized, and only read from
+ * then on. Banned identifiers are interned, so a check finds whether an
+ * identifier is banned from its symbol with one lookup; banned sequences
+ * make one SequenceMatcher and deprecated includes a PathTrie, so that the
+ * cost of linting a file doesn't grow with the lists.
+ */
+class LintConfig {
+ public:
+  LintConfig();
+
+  /**
+   * Adds the lists of a config file to the built-in ones
+   *
+   * @param path
+   *        The path of a JSON file
+   * @return
+   *        Returns false, after printing why, if it can't be read or used
+   */
+  auto load(const std::string& path) -> bool;
+
+  /**
+   * @return
+   *        Returns what the identifier with that symbol is banned for, or
+   *        nullptr if it isn't
+   */
+  auto bannedIdentifier(Symbol symbol) const -> const BannedIdentifier* {
+    if (symbol >= m_identifierAt.size() || m_identifierAt[symbol] == 0) return nullptr;
+    return &m_identifiers[m_identifierAt[symbol] - 1];
+  };
+
+  /**
+   * @return
+   *        Returns the TokenList::symbolBit()s of the banned identifiers
+   */
+  auto bannedSymbolBits() const -> uint64_t { return m_symbolBits; };
+
+  /**
+   * The banned sequences, then the allowed ones; sequence i of the matcher
+   * is banned if i < bannedSequences().size()
+   */
+  auto sequenceMatcher() const -> const SequenceMatcher& { return m_matcher; };
+  auto bannedSequences() const -> const std::vector<BannedSequence>& { return m_sequences; };
+
+  /**
+   * @param path
+   *        The path of an #include, without its quotes
+   */
+  auto isDeprecatedInclude(const StringFragment& path) const -> bool { return m_includes.contains(path); };
+
+  /**
+   * @return
+   *        Returns the text of the config file, which decides what the
+   *        checks report as much as the checks themselves; empty if none
+   */
+  auto source() const -> const std::string& { return m_source; };
+
+ private:
+  void banIdentifier(Symbol symbol, Lint level, std::string message);
+  void compileSequences();
+
+  std::vector<BannedIdentifier>          m_identifiers;
+  std::vector<uint32_t>                  m_identifierAt;  // By symbol, 1 + the index in m_identifiers, or 0
+  uint64_t                               m_symbolBits = 0;
+  std::vector<BannedSequence>            m_sequences;
+  std::vector<SequenceMatcher::Sequence> m_allowed;  // Each ends with the banned sequence it allows
+  SequenceMatcher                        m_matcher;
+  PathTrie                               m_includes;
+  std::string                            m_source;
+};
+extern LintConfig Config;
+};  // namespace flint
@@ -0,0 +1,135 @@
+#include "Dispatcher.hpp"
+
+#include <cassert>
+
+#include "Stats.hpp"
+
+using namespace std;
+
+namespace flint {
+
+void Dispatcher::add(unique_ptr<TokenCheck> check) {
+  const size_t index = m_visitors.size();
+  assert(index < 64 && "one bit per TokenCheck in m_wanted");
+
+  for (const TokenType type: check->triggers()) m_wanted[type] |= uint64_t{1} << index;
+  m_steps.push_back({check.get(), nullptr});
+  m_visitors.emplace_back();
+  Visitor& visitor = m_visitors.back();
+
+  string label;
+  for (const Symbol symbol: check->symbols()) {
+    visitor.symbols |= TokenList::symbolBit(symbol);
+    label += (label.empty() ? "" : ", ") + Symbols.name(symbol);
+  }
+  if (visitor.symbols != 0) visitor.prefilter = addPrefilter(label);
+  visitor.check = move(check);
+};
+
+void Dispatcher::add(StructCheck check) {
+  m_steps.push_back({nullptr, check});
+};
+
+void Dispatcher::run(ErrorFile& errors, const string& path, const TokenList& tokens, const ScopeTree& scopes) {
+  try {
+    uint64_t started = 0, symbols = 0;
+    for (size_t i = 0; i < m_visitors.size(); ++i) {
+      Visitor& visitor = m_visitors[i];
+      visitor.next     = 0;
+      if (!visitor.check->start(visitor.found, path, tokens)) continue;
+      started |= uint64_t{1} << i;
+      symbols |= visitor.symbols;
+    }
+
+    // Skip the checks none of whose symbols are in the file
+    if (symbols != 0) {
+      const uint64_t found = tokens.seenSymbols();
+      for (size_t i = 0; i < m_visitors.size(); ++i) {
+        const Visitor& visitor = m_visitors[i];
+        if ((started & (uint64_t{1} << i)) == 0 || visitor.symbols == 0) continue;
+
+        PrefilterStats& prefilter = Stats.prefilters[visitor.prefilter];
+        prefilter.files.fetch_add(1, memory_order_relaxed);
+        if ((visitor.symbols & found) != 0) continue;
+        prefilter.skipped.fetch_add(1, memory_order_relaxed);
+        started &= ~(uint64_t{1} << i);
+      }
+    }
+
+    // A check whose trigger tokens are rare is handed their positions
+    // straight away; the others share a sweep over every token
+    const size_t size  = tokens.size();
+    uint64_t     swept = 0;
+    for (size_t i = 0; i < m_visitors.size(); ++i) {
+      if ((started & (uint64_t{1} << i)) == 0) continue;
+
+      Visitor& visitor    = m_visitors[i];
+      size_t   candidates = 0;
+      for (const TokenType type: visitor.check->triggers()) candidates += tokens.count(type);
+
+      if (candidates * 8 < size)
+        visitPositions(visitor, path, tokens);
+      else
+        swept |= uint64_t{1} << i;
+    }
+
+    // The sweep: each token is read once, whatever the number of checks
+    const uint8_t* types  = tokens.types();
+    uint64_t       active = swept;
+    for (size_t pos = 0; pos < size && active != 0; ++pos) {
+      uint64_t wanted = m_wanted[types[pos]] & active;
+      for (size_t i = 0; wanted != 0; ++i, wanted >>= 1) {
+        if ((wanted & 1) == 0) continue;
+
+        Visitor& visitor = m_visitors[i];
+        if (pos < visitor.next) continue;
+        visitor.next = visitor.check->visit(visitor.found, path, tokens, pos);
+        assert(visitor.next > pos);
+        if (visitor.next >= size) active &= ~(uint64_t{1} << i);
+      }
+    }
+
+    for (size_t i = 0; i < m_visitors.size(); ++i) {
+      if ((started & (uint64_t{1} << i)) != 0) m_visitors[i].check->finish(m_visitors[i].found, path, tokens);
+    }
+
+    // Collect in order, running the structure checks in their turn
+    size_t visited = 0;
+    for (const Step& step: m_steps) {
+      if (step.tokenCheck != nullptr)
+        m_visitors[visited++].found.moveErrorsTo(errors);
+      else
+        step.structCheck(errors, path, tokens, scopes);
+    }
+  }
+  catch (...) {
+    // Don't let the reports of a file that failed leak into the next one
+    ErrorFile dropped{""};
+    for (Visitor& visitor: m_visitors) visitor.found.moveErrorsTo(dropped);
+    throw;
+  }
+};
+
+void Dispatcher::visitPositions(Visitor& visitor, const string& path, const TokenList& tokens) {
+  // One cursor per trigger type, merged on the fly
+  m_cursors.clear();
+  for (const TokenType type: visitor.check->triggers()) {
+    const vector<uint32_t>& found = tokens.positions(type);
+    if (!found.empty()) m_cursors.push_back({found.data(), found.data() + found.size()});
+  }
+
+  const size_t size = tokens.size();
+  while (visitor.next < size) {
+    size_t pos = size;
+    for (Cursor& cursor: m_cursors) {
+      while (cursor.at != cursor.end && *cursor.at < visitor.next) ++cursor.at;
+      if (cursor.at != cursor.end && *cursor.at < pos) pos = *cursor.at;
+    }
+    if (pos == size) break;
+
+    visitor.next = visitor.check->visit(visitor.found, path, tokens, pos);
+    assert(visitor.next > pos);
+  }
+};
+
+};  // namespace flint
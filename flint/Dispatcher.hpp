@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ErrorReport.hpp"
+#include "Scopes.hpp"
+#include "Tokenizer.hpp"
+
+namespace flint {
+
+/*
+ * A check that only needs to look at the tokens of a few types, in order
+ *
+ * Rather than each check looping over the whole file, the Dispatcher hands
+ * every check the positions whose type it asked for: straight from the
+ * TokenList's positions() when those types are rare in the file, or else
+ * during a single walk over the tokens shared by the checks. visit()
+ * returns the position the check wants to look at next, so a check can
+ * still skip ahead (over a block, a template, ...) exactly as its own loop
+ * used to.
+ *
+ * A check that can only report on a few identifiers (memset, NULL, ...)
+ * names their Symbols too, and is skipped on every file where none of
+ * them occur.
+ *
+ * One instance is kept per thread and reused for every file, so any state
+ * a check keeps between visits must be reset in start().
+ */
+class TokenCheck {
+ public:
+  /**
+   * @param triggers
+   *        The token types visit() is called on
+   * @param symbols
+   *        If any, the identifiers the check is looking for; files holding
+   *        none of them are skipped
+   */
+  explicit TokenCheck(std::initializer_list<TokenType> triggers, std::initializer_list<Symbol> symbols = {})
+      : m_triggers(triggers), m_symbols(symbols){};
+  virtual ~TokenCheck() = default;
+
+  auto triggers() const -> const std::vector<TokenType>& { return m_triggers; };
+  auto symbols() const -> const std::vector<Symbol>& { return m_symbols; };
+
+  /**
+   * Called before the tokens of a file are visited
+   *
+   * @return
+   *        Returns false to skip the file altogether
+   */
+  virtual auto start(ErrorFile& errors, const std::string& path, const TokenList& tokens) -> bool { return true; };
+
+  /**
+   * Called on each token of one of the trigger types, in order
+   *
+   * @param pos
+   *        The position of the token inside the token list
+   * @return
+   *        Returns the first position to visit next, at least pos + 1;
+   *        tokens.size() once the check is done with the file
+   */
+  virtual auto visit(ErrorFile& errors, const std::string& path, const TokenList& tokens, size_t pos)
+      -> size_t = 0;
+
+  /**
+   * Called after the last token, unless the file was skipped
+   */
+  virtual void finish(ErrorFile& errors, const std::string& path, const TokenList& tokens){};
+
+ private:
+  const std::vector<TokenType> m_triggers;
+  const std::vector<Symbol>    m_symbols;
+};
+
+/*
+ * Runs a list of checks over a file, sweeping the tokens at most once for
+ * all the TokenChecks among them. Their reports are kept apart while sweeping, and
+ * collected in the order the checks were added, so a file's report reads
+ * the same as if each check had run on its own, one after the other.
+ */
+class Dispatcher {
+ public:
+  using StructCheck = void (*)(ErrorFile&, const std::string&, const TokenList&, const ScopeTree&);
+
+  /**
+   * Adds a check which visits tokens during the shared sweep
+   */
+  void add(std::unique_ptr<TokenCheck> check);
+
+  /**
+   * Adds a check that needs to move around the whole file, and its scopes;
+   * it runs on its own after the sweep
+   */
+  void add(StructCheck check);
+
+  auto empty() const -> bool { return m_steps.empty(); };
+
+  /**
+   * Runs every check on a file
+   *
+   * @param errors
+   *        Where the reports of all checks are added
+   * @param path
+   *        The path to the file currently being linted
+   * @param tokens
+   *        The token list for the file
+   * @param scopes
+   *        The scopes of the file
+   */
+  void run(ErrorFile& errors, const std::string& path, const TokenList& tokens, const ScopeTree& scopes);
+
+ private:
+  // A check in the order it was added; exactly one of the two is set
+  struct Step {
+    TokenCheck* tokenCheck;
+    StructCheck structCheck;
+  };
+
+  struct Visitor {
+    std::unique_ptr<TokenCheck> check;
+    ErrorFile                   found{""};  // Its reports for the current file
+    size_t                      next{0};    // The first position it still wants to see
+    uint64_t                    symbols{0};    // The TokenList::symbolBit()s of its symbols, if any
+    size_t                      prefilter{0};  // Its counters in Stats.prefilters
+  };
+
+  struct Cursor {
+    const uint32_t* at;
+    const uint32_t* end;
+  };
+
+  /**
+   * Visits the tokens a check is triggered by from their positions alone,
+   * without looking at the others
+   */
+  void visitPositions(Visitor& visitor, const std::string& path, const TokenList& tokens);
+
+  std::vector<Step>    m_steps;
+  std::vector<Visitor> m_visitors;
+  std::vector<Cursor>  m_cursors;  // Only used by visitPositions(), kept to reuse its memory
+  // Bit i of m_wanted[type] is set if the visitor i is triggered by that type
+  uint64_t m_wanted[NUM_TOKENS] = {};
+};
+
+};  // namespace flint
@@ -23,15 +23,18 @@ class ErrorObject {
   ErrorObject(Lint type, size_t line, std::string title, std::string desc)
       : m_type(type), m_line(line), m_title(move(title)), m_desc(move(desc)){};
 
-  // Getter
+  // Getters
   auto getType() const -> size_t { return m_type; };
+  auto getLine() const -> size_t { return m_line; };
+  auto getTitle() const -> const std::string& { return m_title; };
+  auto getDesc() const -> const std::string& { return m_desc; };
 
   /*
    * Prints a single error of the report in either
    * JSON or Pretty Printed format
    *
    */
-  void print(const std::string& path) const {
+  void print(const std::string& path, std::ostream& out = std::cout) const {
     static constexpr std::array<const char*, 3> levelStr{"[Error  ] ", "[Warning] ", "[Advice ] "};
     static constexpr std::array<const char*, 3> levelStrJSON{"Error", "Warning", "Advice"};
 
@@ -40,7 +43,7 @@ class ErrorObject {
 
     // clang-format off
     if (Options.JSON) {
-      std::cout <<
+      out <<
                 "        {\n"
                 "\t        \"level\"    : \"" << levelStrJSON[m_type]   << "\",\n"
                 "\t        \"line\"     : "   << std::to_string(m_line) << ",\n"
@@ -50,7 +53,7 @@ class ErrorObject {
       return;
     }
     // clang-format on
-    std::cout << levelStr[m_type] << path << ':' << std::to_string(m_line) << ": " << m_title << std::endl;
+    out << levelStr[m_type] << path << ':' << std::to_string(m_line) << ": " << m_title << std::endl;
   };
 };
 
@@ -81,6 +84,9 @@ class ErrorFile: public ErrorBase {
  public:
   explicit ErrorFile(std::string path): ErrorBase(), m_path(move(path)){};
 
+  auto getPath() const -> const std::string& { return m_path; };
+  auto getErrorObjects() const -> const std::vector<ErrorObject>& { return m_objs; };
+
   void addError(ErrorObject&& error) {
     switch (error.getType()) {
       case Lint::WARNING:
@@ -95,14 +101,24 @@ class ErrorFile: public ErrorBase {
     m_objs.push_back(std::move(error));
   };
 
+  /**
+   * Moves all of this file's errors to the end of another's, leaving this
+   * one empty
+   */
+  void moveErrorsTo(ErrorFile& other) {
+    for (auto& obj: m_objs) other.addError(std::move(obj));
+    m_objs.clear();
+    m_errors = m_warnings = m_advice = 0;
+  };
+
   /*
    * Prints a single file of the report in either
    * JSON or Pretty Printed format
    */
-  void print() const {
+  void print(std::ostream& out = std::cout) const {
     // clang-format off
     if (Options.JSON) {
-      std::cout <<
+      out <<
                 "    {\n"
                 "\t    \"path\"     : \"" << escapeString(m_path)          << "\",\n"
                 "\t    \"errors\"   : "   << std::to_string(getErrors())   << ",\n"
@@ -111,15 +127,15 @@ class ErrorFile: public ErrorBase {
                 "\t    \"reports\"  : [\n";
       // clang-format on
       for (size_t i = 0, size = m_objs.size(); i < size; ++i) {
-        if (i > 0) std::cout << ',' << std::endl;
-        m_objs[i].print(m_path);
+        if (i > 0) out << ',' << std::endl;
+        m_objs[i].print(m_path, out);
       }
-      std::cout << "\n      ]\n    }";
+      out << "\n      ]\n    }";
 
       return;
     }
 
-    for (const auto& m_obj: m_objs) { m_obj.print(m_path); }
+    for (const auto& m_obj: m_objs) { m_obj.print(m_path, out); }
   };
 };
 
@@ -130,48 +146,77 @@ class ErrorReport: public ErrorBase {
  private:
   // Members
   std::vector<ErrorFile> m_files;
+  size_t                 m_fileCount{0};
 
  public:
   void addFile(ErrorFile file) {
+    countFile(file);
+    m_files.push_back(std::move(file));
+  };
+
+  /*
+   * Adds a file's counts to the report without keeping the file,
+   * for callers that print each file themselves with printFile()
+   */
+  void countFile(const ErrorFile& file) {
     m_errors += file.getErrors();
     m_warnings += file.getWarnings();
     m_advice += file.getAdvice();
-
-    m_files.push_back(std::move(file));
+    ++m_fileCount;
   };
 
   /*
-   * Prints an entire report in either
-   * JSON or Pretty Printed format
+   * Prints one file of the report, given its position among the files
    */
-  void print() const {
+  static void printFile(const ErrorFile& file, size_t index, std::ostream& out = std::cout) {
     if (Options.JSON) {
-      // clang-format off
-      std::cout << "{\n"
-                "\t\"errors\"   : " << std::to_string(getErrors())   << ",\n"
-                "\t\"warnings\" : " << std::to_string(getWarnings()) << ",\n"
-                "\t\"advice\"   : " << std::to_string(getAdvice())   << ",\n"
-                "\t\"files\"    : [\n";
-      // clang-format on
-      for (size_t i = 0, size = m_files.size(); i < size; ++i) {
-        if (i > 0) std::cout << ',' << std::endl;
-        m_files[i].print();
-      }
-      std::cout << "\n  ]\n}";
+      if (index > 0) out << ',' << std::endl;
+      file.print(out);
+    } else if (file.getTotal() > 0) {
+      file.print(out);
+    }
+  };
+
+  /*
+   * Prints what comes before the files: the totals in JSON format,
+   * nothing when Pretty Printed
+   */
+  void printHeader(std::ostream& out = std::cout) const {
+    if (!Options.JSON) return;
+    // clang-format off
+    out << "{\n"
+        "\t\"errors\"   : " << std::to_string(getErrors())   << ",\n"
+        "\t\"warnings\" : " << std::to_string(getWarnings()) << ",\n"
+        "\t\"advice\"   : " << std::to_string(getAdvice())   << ",\n"
+        "\t\"files\"    : [\n";
+    // clang-format on
+  };
 
+  /*
+   * Prints what comes after the files: the closing brackets
+   * in JSON format, the summary when Pretty Printed
+   */
+  void printFooter(std::ostream& out = std::cout) const {
+    if (Options.JSON) {
+      out << "\n  ]\n}";
       return;
     }
 
-    for (const auto& m_file: m_files) {
-      if (m_file.getTotal() > 0) { m_file.print(); }
-    }
+    out << "\nLint Summary: " << std::to_string(m_fileCount) << " files\nErrors: " << std::to_string(getErrors());
 
-    std::cout << "\nLint Summary: " << std::to_string(m_files.size())
-              << " files\nErrors: " << std::to_string(getErrors());
+    if (Options.LEVEL >= Lint::WARNING) out << " Warnings: " << std::to_string(getWarnings());
+    if (Options.LEVEL >= Lint::ADVICE) out << " Advice: " << std::to_string(getAdvice());
+    out << std::endl;
+  };
 
-    if (Options.LEVEL >= Lint::WARNING) std::cout << " Warnings: " << std::to_string(getWarnings());
-    if (Options.LEVEL >= Lint::ADVICE) std::cout << " Advice: " << std::to_string(getAdvice());
-    std::cout << std::endl;
+  /*
+   * Prints an entire report in either
+   * JSON or Pretty Printed format
+   */
+  void print(std::ostream& out = std::cout) const {
+    printHeader(out);
+    for (size_t i = 0, size = m_files.size(); i < size; ++i) printFile(m_files[i], i, out);
+    printFooter(out);
   };
 };
 
@@ -12,6 +12,11 @@ enum FileCategory {
   SOURCE_CPP,
   UNKNOWN,
 };
+constexpr unsigned NUM_FILE_CATEGORIES = FileCategory::UNKNOWN + 1;
+
+// Sets of categories, such as the files a check applies to
+constexpr auto categoryBit(FileCategory category) -> unsigned { return 1u << category; };
+constexpr unsigned ALL_FILE_CATEGORIES = (1u << NUM_FILE_CATEGORIES) - 1;
 
 // File identifying functions...
 auto getFileCategory(const std::string& path) -> FileCategory;
@@ -0,0 +1,240 @@
+#include "FileLists.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "ErrorReport.hpp"
+#include "FileCategories.hpp"
+#include "Json.hpp"
+#include "Polyfill.hpp"
+
+#ifdef _WIN32
+#define popen  _popen
+#define pclose _pclose
+#endif
+
+using namespace std;
+
+namespace flint {
+
+void ChangedLines::add(const string& path, size_t first, size_t last) {
+  auto& ranges = m_ranges[path];
+  ranges.emplace_back(first, last);
+  // Hunks arrive in order, so this is almost always a no-op
+  if (ranges.size() > 1 && ranges[ranges.size() - 2].first > first) sort(ranges.begin(), ranges.end());
+};
+
+auto ChangedLines::contains(const string& path, size_t line) const -> bool {
+  const auto it = m_ranges.find(path);
+  if (it == m_ranges.end()) return false;
+
+  // The first range ending at or after line is the only one that can hold it
+  const auto& ranges = it->second;
+  const auto  range  = lower_bound(ranges.begin(), ranges.end(), line,
+                                 [](const pair<size_t, size_t>& r, size_t l) { return r.second < l; });
+  return range != ranges.end() && range->first <= line;
+};
+
+void ChangedLines::filter(const string& path, LintResult& result) const {
+  if (!result.file) return;
+
+  const ErrorFile& file = *result.file;
+  unique_ptr<ErrorFile> kept{new ErrorFile(file.getPath())};
+  for (const auto& object: file.getErrorObjects()) {
+    if (contains(path, object.getLine())) kept->addError(ErrorObject(object));
+  }
+  result.file = move(kept);
+};
+
+namespace {
+/**
+ * Quotes a single argument for the shell popen() runs
+ */
+auto shellQuote(const string& arg) -> string {
+#ifdef _WIN32
+  return '"' + arg + '"';
+#else
+  string quoted = "'";
+  for (const char c: arg) {
+    if (c == '\'')
+      quoted += "'\\''";
+    else
+      quoted += c;
+  }
+  return quoted + '\'';
+#endif
+};
+
+/**
+ * Runs a command and collects everything it writes to stdout
+ *
+ * @return
+ *        Returns false if it could not be run or did not exit successfully
+ */
+auto runCommand(const string& command, string& output) -> bool {
+  FILE* pipe = popen(command.c_str(), "r");
+  if (!pipe) return false;
+
+  char buffer[64 * 1024];
+  while (const size_t got = fread(buffer, 1, sizeof(buffer), pipe)) output.append(buffer, got);
+  return pclose(pipe) == 0;
+};
+
+/**
+ * Undoes the C-style quoting git applies to paths holding unusual characters
+ */
+auto unquotePath(const string& path) -> string {
+  if (path.size() < 2 || path.front() != '"' || path.back() != '"') return path;
+
+  string result;
+  for (size_t i = 1; i + 1 < path.size(); ++i) {
+    char c = path[i];
+    if (c == '\\' && i + 2 < path.size()) {
+      c = path[++i];
+      switch (c) {
+        case 'n': c = '\n'; break;
+        case 't': c = '\t'; break;
+        case 'a': c = '\a'; break;
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'r': c = '\r'; break;
+        case 'v': c = '\v'; break;
+        default:
+          // Three octal digits encode a byte of a multibyte character
+          if (c >= '0' && c <= '7' && i + 3 < path.size()) {
+            c = static_cast<char>(strtol(path.substr(i, 3).c_str(), nullptr, 8));
+            i += 2;
+          }
+      }
+    }
+    result += c;
+  }
+  return result;
+};
+
+/**
+ * Picks the changed files and their new line ranges out of a zero
+ * context diff
+ */
+void parseDiff(const string& diff, vector<string>& files, ChangedLines& lines) {
+  string path;
+  bool   lintable = false;
+  for (size_t pos = 0, end; pos < diff.size(); pos = end + 1) {
+    end = diff.find('\n', pos);
+    if (end == string::npos) end = diff.size();
+    const char* line = diff.c_str() + pos;
+
+    if (startsWith(line, "+++ ")) {
+      // Names holding a space are followed by a tab
+      size_t nameEnd = end;
+      if (nameEnd > pos + 4 && diff[nameEnd - 1] == '\t') --nameEnd;
+      path     = unquotePath(diff.substr(pos + 4, nameEnd - pos - 4));
+      lintable = startsWith(path.c_str(), "b/");
+      if (!lintable) continue;
+      path     = path.substr(2);
+      lintable = getFileCategory(path) != FileCategory::UNKNOWN;
+      if (lintable) files.push_back(path);
+    } else if (lintable && startsWith(line, "@@ ")) {
+      // "@@ -old[,count] +new[,count] @@"; a count of 0 is a pure deletion
+      const char* plus = strchr(line, '+');
+      if (!plus || plus > diff.c_str() + end) continue;
+      char*         rest  = nullptr;
+      const size_t  first = strtoul(plus + 1, &rest, 10);
+      const size_t  count = (*rest == ',') ? strtoul(rest + 1, nullptr, 10) : 1;
+      if (count > 0) lines.add(path, first, first + count - 1);
+    }
+  }
+};
+};  // namespace
+
+auto gitChangedFiles(const string& rev, const vector<string>& pathspecs, vector<string>& files, ChangedLines* lines)
+    -> bool {
+  // Only the working tree and the local object store are consulted; --relative
+  // makes the paths relative to (and limited to) the current directory
+  string command = "git -c core.quotePath=false diff --no-color --no-ext-diff --relative --diff-filter=d ";
+  command += lines ? "-U0 --src-prefix=a/ --dst-prefix=b/ " : "--name-only -z ";
+  command += shellQuote(rev) + " --";
+  for (const auto& pathspec: pathspecs) command += ' ' + shellQuote(pathspec);
+
+  string output;
+  if (!runCommand(command, output)) {
+    fprintf(stderr, "Could not list the files changed since '%s'; is this a git repository?\n\n", rev.c_str());
+    return false;
+  }
+
+  if (lines) {
+    parseDiff(output, files, *lines);
+    return true;
+  }
+
+  for (size_t pos = 0, end; pos < output.size(); pos = end + 1) {
+    end = output.find('\0', pos);
+    if (end == string::npos) end = output.size();
+    string path = output.substr(pos, end - pos);
+    if (!path.empty() && getFileCategory(path) != FileCategory::UNKNOWN) files.push_back(move(path));
+  }
+  return true;
+};
+
+auto readFileList(const string& source, vector<string>& files) -> bool {
+  string list;
+  if (source == "-") {
+    char buffer[64 * 1024];
+    while (const size_t got = fread(buffer, 1, sizeof(buffer), stdin)) list.append(buffer, got);
+  } else {
+    FileBuffer contents;
+    if (!contents.load(source)) {
+      fprintf(stderr, "Cannot read file list '%s'.\n\n", source.c_str());
+      return false;
+    }
+    list.assign(contents.begin(), contents.end());
+  }
+
+  // Lists written by find -print0 and friends hold names that may contain newlines
+  const char separator = list.find('\0') != string::npos ? '\0' : '\n';
+  for (size_t pos = 0, end; pos < list.size(); pos = end + 1) {
+    end = list.find(separator, pos);
+    if (end == string::npos) end = list.size();
+    size_t nameEnd = end;
+    if (separator == '\n' && nameEnd > pos && list[nameEnd - 1] == '\r') --nameEnd;
+
+    string path = list.substr(pos, nameEnd - pos);
+    if (!path.empty() && getFileCategory(path) != FileCategory::UNKNOWN) files.push_back(move(path));
+  }
+  return true;
+};
+
+auto readCompileCommands(const string& path, vector<string>& files) -> bool {
+  FileBuffer contents;
+  if (!contents.load(path)) {
+    fprintf(stderr, "Cannot read compilation database '%s'.\n\n", path.c_str());
+    return false;
+  }
+
+  JsonValue database;
+  string    error;
+  if (!parseJson(contents.begin(), contents.end(), database, error)) {
+    fprintf(stderr, "Cannot parse compilation database '%s': %s.\n\n", path.c_str(), error.c_str());
+    return false;
+  }
+  if (database.type != JsonValue::ARRAY) {
+    fprintf(stderr, "Compilation database '%s' is not an array of commands.\n\n", path.c_str());
+    return false;
+  }
+
+  for (const auto& command: database.array) {
+    const JsonValue* file = command.find("file");
+    if (!file || file->type != JsonValue::STRING || getFileCategory(file->text) == FileCategory::UNKNOWN) continue;
+
+    // Relative names are relative to the directory the command runs in
+    const JsonValue* directory = command.find("directory");
+    if (fsIsAbsolute(file->text) || !directory || directory->type != JsonValue::STRING)
+      files.push_back(normalizePath(file->text));
+    else
+      files.push_back(normalizePath(directory->text + FS_SEP + file->text));
+  }
+  return true;
+};
+};  // namespace flint
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Linter.hpp"
+
+namespace flint {
+
+/*
+ * The lines of each file that a diff added or changed
+ */
+class ChangedLines {
+ public:
+  /**
+   * Marks a range of lines of a file as changed
+   *
+   * @param path
+   *        The file, spelled as it will be linted
+   * @param first
+   *        The first changed line
+   * @param last
+   *        The last changed line
+   */
+  void add(const std::string& path, size_t first, size_t last);
+
+  auto contains(const std::string& path, size_t line) const -> bool;
+
+  /**
+   * Drops every error of a lint result that lies outside the changed lines
+   *
+   * @param path
+   *        The file the result is for
+   * @param result
+   *        The result to filter
+   */
+  void filter(const std::string& path, LintResult& result) const;
+
+ private:
+  // Sorted, non-overlapping ranges of changed lines per file
+  std::unordered_map<std::string, std::vector<std::pair<size_t, size_t>>> m_ranges;
+};
+
+/**
+ * Asks the local git repository which files differ from a revision
+ *
+ * @param rev
+ *        The revision to compare the working tree against
+ * @param pathspecs
+ *        Only files below these paths are listed
+ * @param files
+ *        Filled with the lintable files that were added or modified,
+ *        relative to the current directory
+ * @param lines
+ *        If not null, filled with the lines changed in each of those files
+ * @return
+ *        Returns false if git could not produce the list
+ */
+auto gitChangedFiles(const std::string& rev, const std::vector<std::string>& pathspecs,
+                     std::vector<std::string>& files, ChangedLines* lines) -> bool;
+
+/**
+ * Reads a list of files, one per line or separated by NULs
+ *
+ * @param source
+ *        The file holding the list, or "-" for stdin
+ * @param files
+ *        The lintable files listed are appended to this
+ * @return
+ *        Returns false if the list could not be read
+ */
+auto readFileList(const std::string& source, std::vector<std::string>& files) -> bool;
+
+/**
+ * Reads the source files out of a compilation database
+ *
+ * @param path
+ *        The compile_commands.json file
+ * @param files
+ *        The lintable files compiled are appended to this
+ * @return
+ *        Returns false if the database could not be read or parsed
+ */
+auto readCompileCommands(const std::string& path, std::vector<std::string>& files) -> bool;
+};  // namespace flint
@@ -0,0 +1,203 @@
+#include "IgnoreRules.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Polyfill.hpp"
+
+using namespace std;
+
+namespace flint {
+
+namespace {
+auto hasGlobChars(const char* begin, const char* end) -> bool {
+  return find_if(begin, end, [](char c) { return c == '*' || c == '?' || c == '[' || c == '\\'; }) != end;
+};
+
+/**
+ * Matches a bracket expression such as "[a-z]" or "[!0-9]"
+ *
+ * @param p
+ *        Points at the '['; moved past the closing ']' on success
+ * @param c
+ *        The character to test
+ * @param matched
+ *        Set to whether the character is in the class
+ * @return
+ *        Returns false if the bracket is never closed, in which case
+ *        it is just a '['
+ */
+auto matchClass(const char*& p, const char* pe, char c, bool& matched) -> bool {
+  const char* q      = p + 1;
+  const bool  negate = q < pe && (*q == '!' || *q == '^');
+  if (negate) ++q;
+
+  bool found = false;
+  // A ']' right at the start is part of the class
+  for (bool first = true; q < pe && (*q != ']' || first); first = false) {
+    char low = *q++;
+    if (low == '\\' && q < pe) low = *q++;
+    char high = low;
+    if (q + 1 < pe && *q == '-' && q[1] != ']') {
+      high = q[1];
+      q += 2;
+      if (high == '\\' && q < pe) high = *q++;
+    }
+    found |= low <= c && c <= high;
+  }
+  if (q >= pe) return false;
+
+  p       = q + 1;
+  matched = (found != negate) && c != '/';
+  return true;
+};
+
+/**
+ * Matches a path against a glob, where '*' and '?' stay within one
+ * name and '**' spans any number of directories
+ */
+auto globMatch(const char* p, const char* pe, const char* s, const char* se) -> bool {
+  while (p < pe) {
+    switch (*p) {
+      case '*': {
+        if (p + 1 < pe && p[1] == '*') {
+          const char* rest = p + 2;
+          if (rest < pe && *rest == '/') {
+            // "**/" is zero or more whole directories
+            ++rest;
+            for (const char* t = s;; ++t) {
+              if (globMatch(rest, pe, t, se)) return true;
+              t = find(t, se, '/');
+              if (t == se) return false;
+            }
+          }
+          // A trailing "/**" takes everything below
+          for (const char* t = s; t <= se; ++t) {
+            if (globMatch(rest, pe, t, se)) return true;
+          }
+          return false;
+        }
+
+        ++p;
+        for (const char* t = s;; ++t) {
+          if (globMatch(p, pe, t, se)) return true;
+          if (t == se || *t == '/') return false;
+        }
+      }
+      case '?':
+        if (s == se || *s == '/') return false;
+        ++p;
+        ++s;
+        break;
+      case '[': {
+        bool matched = false;
+        if (s < se && matchClass(p, pe, *s, matched)) {
+          if (!matched) return false;
+          ++s;
+          break;
+        }
+        if (s == se || *s != '[') return false;
+        ++p;
+        ++s;
+        break;
+      }
+      case '\\':
+        if (p + 1 < pe) ++p;
+        // Fall through to match the escaped character itself
+      default:
+        if (s == se || *s != *p) return false;
+        ++p;
+        ++s;
+    }
+  }
+  return s == se;
+};
+};  // namespace
+
+IgnoreRules::IgnoreRules(shared_ptr<const IgnoreRules> parent, string base)
+    : m_parent(move(parent)), m_base(move(base)){};
+
+auto IgnoreRules::load(const string& path) -> bool {
+  FileBuffer contents;
+  if (!contents.load(path)) return false;
+
+  for (const char *line = contents.begin(), *next; line < contents.end(); line = next + 1) {
+    next = find(line, contents.end(), '\n');
+
+    // Trailing whitespace is dropped unless escaped
+    const char* end = next;
+    while (end > line && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t')) {
+      if (end - 1 > line && end[-2] == '\\') break;
+      --end;
+    }
+    if (end == line || *line == '#') continue;
+
+    Rule rule;
+    rule.negated = *line == '!';
+    if (rule.negated) ++line;
+    // "\#" and "\!" start patterns that really begin with those characters
+    if (end - line > 1 && *line == '\\' && (line[1] == '#' || line[1] == '!')) ++line;
+
+    rule.dirOnly = end > line && end[-1] == '/';
+    if (rule.dirOnly) --end;
+    rule.anchored = find(line, end, '/') != end;
+    if (end > line && *line == '/') ++line;
+    if (end == line) continue;
+
+    if (!hasGlobChars(line, end)) {
+      rule.kind = Rule::LITERAL;
+      rule.pattern.assign(line, end);
+    } else if (!rule.anchored && *line == '*' && !hasGlobChars(line + 1, end)) {
+      // "*.pb.h" and the like only need a look at the end of the name
+      rule.kind = Rule::SUFFIX;
+      rule.pattern.assign(line + 1, end);
+    } else {
+      rule.kind = Rule::GLOB;
+      rule.pattern.assign(line, end);
+    }
+    m_rules.push_back(move(rule));
+  }
+  return !m_rules.empty();
+};
+
+auto IgnoreRules::ignored(const string& dir, const string& name, bool isDir) const -> bool {
+  // The deepest .flintignore with an opinion decides
+  for (const IgnoreRules* rules = this; rules; rules = rules->m_parent.get()) {
+    const Match result = rules->match(dir, name, isDir);
+    if (result != Match::NONE) return result == Match::EXCLUDED;
+  }
+  return false;
+};
+
+auto IgnoreRules::match(const string& dir, const string& name, bool isDir) const -> Match {
+  string relative;  // the entry's path below m_base, built the first time it is needed
+
+  for (auto rule = m_rules.rbegin(); rule != m_rules.rend(); ++rule) {
+    if (rule->dirOnly && !isDir) continue;
+
+    if (rule->anchored && relative.empty()) {
+      relative = dir.size() > m_base.size() ? dir.substr(m_base.size() + FS_SEP.size()) + '/' + name : name;
+#ifdef _WIN32
+      replace(relative.begin(), relative.end(), '\\', '/');
+#endif
+    }
+    const string& subject = rule->anchored ? relative : name;
+
+    bool matched;
+    switch (rule->kind) {
+      case Rule::LITERAL:
+        matched = subject == rule->pattern;
+        break;
+      case Rule::SUFFIX:
+        matched = subject.size() >= rule->pattern.size() &&
+                  subject.compare(subject.size() - rule->pattern.size(), string::npos, rule->pattern) == 0;
+        break;
+      default:
+        matched = globMatch(rule->pattern.data(), rule->pattern.data() + rule->pattern.size(), subject.data(),
+                            subject.data() + subject.size());
+    }
+    if (matched) return rule->negated ? Match::INCLUDED : Match::EXCLUDED;
+  }
+  return Match::NONE;
+};
+};  // namespace flint
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace flint {
+
+/*
+ * The patterns of a .flintignore file, which hides files and subdirectories
+ * from the walk using the same syntax as .gitignore:
+ *
+ *   - blank lines and lines starting with '#' are skipped
+ *   - a leading '!' re-includes what an earlier pattern excluded
+ *   - a trailing '/' only matches directories
+ *   - a pattern with no other '/' matches a name at any depth, while one
+ *     with a '/' is relative to the directory holding the .flintignore
+ *   - '*', '?' and '[...]' match within a name, and '**' across directories
+ *
+ * Each file is parsed once, when its directory is listed. A directory's
+ * rules are chained to those of its parent, and like in git the deepest
+ * file with a matching pattern decides, the last match within it winning.
+ */
+class IgnoreRules {
+ public:
+  /**
+   * @param parent
+   *        The rules in effect for the enclosing directory, if any
+   * @param base
+   *        The directory holding the .flintignore
+   */
+  IgnoreRules(std::shared_ptr<const IgnoreRules> parent, std::string base);
+
+  /**
+   * Reads and compiles the patterns of a .flintignore file
+   *
+   * @param path
+   *        The .flintignore to read
+   * @return
+   *        Returns false if it could not be read or holds no patterns
+   */
+  auto load(const std::string& path) -> bool;
+
+  /**
+   * Decides whether an entry of a directory is ignored
+   *
+   * @param dir
+   *        The directory being listed, at or below the base directory
+   * @param name
+   *        The name of the entry
+   * @param isDir
+   *        Whether the entry is a directory
+   * @return
+   *        Returns true if the entry should not be walked
+   */
+  auto ignored(const std::string& dir, const std::string& name, bool isDir) const -> bool;
+
+ private:
+  struct Rule {
+    enum Kind { LITERAL, SUFFIX, GLOB };
+
+    std::string pattern;  // without the '!', leading '/' and trailing '/'
+    Kind        kind;
+    bool        negated;
+    bool        dirOnly;
+    bool        anchored;  // matched against the path below m_base, not the name
+  };
+
+  enum Match { NONE, INCLUDED, EXCLUDED };
+
+  auto match(const std::string& dir, const std::string& name, bool isDir) const -> Match;
+
+  std::shared_ptr<const IgnoreRules> m_parent;
+  std::string                        m_base;
+  std::vector<Rule>                  m_rules;
+};
+};  // namespace flint
@@ -1,6 +1,8 @@
 #include "Ignored.hpp"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 using namespace std;
 
@@ -10,42 +12,66 @@ namespace flint {
 static const string kIgnorePause{R"(// %flint: pause)"};
 static const string kIgnoreResume{R"(// %flint: resume)"};
 
+/**
+ * Finds the first instance of a marker in a range
+ *
+ * @param from
+ *        Where to start searching
+ * @param end
+ *        Where to stop searching
+ * @param marker
+ *        The marker to search for
+ * @return
+ *        Returns the position of the marker, or nullptr if it was not found
+ */
+static auto findMarker(const char* from, const char* end, const string& marker) -> const char* {
+  const size_t len = marker.size();
+  while (static_cast<size_t>(end - from) >= len) {
+    from = static_cast<const char*>(memchr(from, marker[0], static_cast<size_t>(end - from) - len + 1));
+    if (from == nullptr) break;
+    if (memcmp(from, marker.data(), len) == 0) return from;
+    ++from;
+  }
+  return nullptr;
+};
+
 /**
  * Removed code between lint tags
  *
- * @param file
- *        A string of the file contents to modify
+ * @param begin
+ *        The start of the file contents
+ * @param end
+ *        The end of the file contents
  * @param path
  *        The path the file resides at, for debug messages
+ * @param result
+ *        Filled with the modified contents, if anything was removed
  * @return
- *        Returns the modified string
+ *        Returns true if code was removed and result should be used instead
  */
-auto removeIgnoredCode(const string& file, const string& path) -> string {
-  string result;
-  size_t pos = 0;
-
-  while (true) {
-    size_t posPause = 0;
+auto removeIgnoredCode(const char* begin, const char* end, const string& path, string& result) -> bool {
+  const char* pos      = begin;
+  const char* posPause = findMarker(pos, end, kIgnorePause);
 
-    // Find the position of ignorePause starting from position 'pos'
-    posPause = file.find(kIgnorePause, pos);
+  // The usual case: nothing to remove, so nothing is copied
+  if (posPause == nullptr) return false;
 
+  result.clear();
+  while (true) {
     // If no instance of posPause is found, then add everything from
     // pos to end_of_file to result and return.
-    if (posPause == string::npos) {
-      result += file.substr(pos);
+    if (posPause == nullptr) {
+      result.append(pos, end);
       break;
     } else {
-      size_t posResume = 0;
-
       // If an instance of ignorePause was found, then find the corresponding
       // position of ignoreResume.
-      posResume = file.find(kIgnoreResume, posPause + kIgnorePause.size());
+      const char* posResume = findMarker(posPause + kIgnorePause.size(), end, kIgnoreResume);
 
       // If no instance of ignoreResume was found, then show an error to the
       // user, with the line number for ignorePause.
-      if (posResume == string::npos) {
-        auto lineNo = count(file.begin(), file.begin() + posPause, '\n');
+      if (posResume == nullptr) {
+        auto lineNo = count(begin, posPause, '\n');
         ++lineNo;
 
         fprintf(stderr,
@@ -55,24 +81,25 @@ auto removeIgnoredCode(const string& file, const string& path) -> string {
                 kIgnoreResume.c_str(),
                 kIgnorePause.c_str());
 
-        result += file.substr(pos);
+        result.append(pos, end);
         break;
       } else {
         // Otherwise add everything from pos to posPause - 1, empty line for
         // each line from posPause to posResume + size(posResume) - 1 so that
         // other lint errors show correct line number, and set pos to the next
         // position after ignoreResume.
-        result += file.substr(pos, posPause - pos);
+        result.append(pos, posPause);
 
-        const auto emptyLinesToAdd =
-            count(file.begin() + posPause, file.begin() + posResume + kIgnoreResume.size(), '\n');
+        const auto emptyLinesToAdd = count(posPause, posResume + kIgnoreResume.size(), '\n');
 
-        result += string(emptyLinesToAdd, '\n');
+        result.append(emptyLinesToAdd, '\n');
         pos = posResume + kIgnoreResume.size();
       }
     }
+
+    posPause = findMarker(pos, end, kIgnorePause);
   }
 
-  return result;
+  return true;
 };
 };  // namespace flint
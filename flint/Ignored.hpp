@@ -7,7 +7,8 @@ namespace flint {
 /**
  * Removes the code that appears between pairs of "// %flint: pause" and
  * "// %flint: resume", so that intentionally written code, that may
- * generate warnings, can be ignored by lint.
+ * generate warnings, can be ignored by lint. Files without any such code
+ * (nearly all of them) are left where they are rather than copied.
  */
-auto removeIgnoredCode(const std::string& file, const std::string& path) -> std::string;
+auto removeIgnoredCode(const char* begin, const char* end, const std::string& path, std::string& result) -> bool;
 };  // namespace flint
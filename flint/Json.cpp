@@ -0,0 +1,257 @@
+#include "Json.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+namespace flint {
+
+auto JsonValue::find(const string& key) const -> const JsonValue* {
+  for (const auto& member: object) {
+    if (member.first == key) return &member.second;
+  }
+  return nullptr;
+};
+
+namespace {
+// Nesting deeper than this is surely not a real configuration file or database
+constexpr size_t kMaxDepth = 256;
+
+/*
+ * A recursive descent parser over a buffer, stopping at the first error
+ */
+class JsonParser {
+ public:
+  JsonParser(const char* begin, const char* end): m_begin(begin), m_pos(begin), m_end(end){};
+
+  auto parseDocument(JsonValue& value, string& error) -> bool {
+    if (parseValue(value, 0)) {
+      skipSpace();
+      if (m_pos == m_end) return true;
+      fail("Unexpected text after the document");
+    }
+    error = m_error;
+    return false;
+  };
+
+ private:
+  const char* m_begin;
+  const char* m_pos;
+  const char* m_end;
+  string      m_error;
+
+  auto fail(const char* what) -> bool {
+    if (m_error.empty()) {
+      size_t line = 1;
+      for (const char* c = m_begin; c < m_pos && c < m_end; ++c) line += (*c == '\n');
+      m_error = string(what) + " on line " + to_string(line);
+    }
+    return false;
+  };
+
+  void skipSpace() {
+    while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\n' || *m_pos == '\r')) ++m_pos;
+  };
+
+  auto consume(const char* word) -> bool {
+    const size_t size = strlen(word);
+    if (static_cast<size_t>(m_end - m_pos) < size || memcmp(m_pos, word, size) != 0) return false;
+    m_pos += size;
+    return true;
+  };
+
+  auto parseValue(JsonValue& value, size_t depth) -> bool {
+    if (depth > kMaxDepth) return fail("Too deeply nested");
+
+    skipSpace();
+    if (m_pos == m_end) return fail("Unexpected end of document");
+
+    switch (*m_pos) {
+      case '{':
+        value.type = JsonValue::OBJECT;
+        return parseObject(value, depth);
+      case '[':
+        value.type = JsonValue::ARRAY;
+        return parseArray(value, depth);
+      case '"':
+        value.type = JsonValue::STRING;
+        return parseString(value.text);
+      case 't':
+        value.type    = JsonValue::BOOL;
+        value.boolean = true;
+        return consume("true") || fail("Invalid literal");
+      case 'f':
+        value.type    = JsonValue::BOOL;
+        value.boolean = false;
+        return consume("false") || fail("Invalid literal");
+      case 'n':
+        value.type = JsonValue::NUL;
+        return consume("null") || fail("Invalid literal");
+      default:
+        value.type = JsonValue::NUMBER;
+        return parseNumber(value.number);
+    }
+  };
+
+  auto parseObject(JsonValue& value, size_t depth) -> bool {
+    ++m_pos;  // '{'
+    skipSpace();
+    if (m_pos < m_end && *m_pos == '}') {
+      ++m_pos;
+      return true;
+    }
+
+    while (true) {
+      skipSpace();
+      string key;
+      if (m_pos == m_end || *m_pos != '"') return fail("Expected a member name");
+      if (!parseString(key)) return false;
+
+      skipSpace();
+      if (m_pos == m_end || *m_pos != ':') return fail("Expected ':'");
+      ++m_pos;
+
+      value.object.emplace_back(move(key), JsonValue());
+      if (!parseValue(value.object.back().second, depth + 1)) return false;
+
+      skipSpace();
+      if (m_pos < m_end && *m_pos == ',') {
+        ++m_pos;
+        continue;
+      }
+      if (m_pos < m_end && *m_pos == '}') {
+        ++m_pos;
+        return true;
+      }
+      return fail("Expected ',' or '}'");
+    }
+  };
+
+  auto parseArray(JsonValue& value, size_t depth) -> bool {
+    ++m_pos;  // '['
+    skipSpace();
+    if (m_pos < m_end && *m_pos == ']') {
+      ++m_pos;
+      return true;
+    }
+
+    while (true) {
+      value.array.emplace_back();
+      if (!parseValue(value.array.back(), depth + 1)) return false;
+
+      skipSpace();
+      if (m_pos < m_end && *m_pos == ',') {
+        ++m_pos;
+        continue;
+      }
+      if (m_pos < m_end && *m_pos == ']') {
+        ++m_pos;
+        return true;
+      }
+      return fail("Expected ',' or ']'");
+    }
+  };
+
+  auto parseHex4(unsigned& code) -> bool {
+    if (m_end - m_pos < 4) return fail("Truncated \\u escape");
+    code = 0;
+    for (int i = 0; i < 4; ++i, ++m_pos) {
+      const char c = *m_pos;
+      code <<= 4;
+      if (c >= '0' && c <= '9')
+        code |= static_cast<unsigned>(c - '0');
+      else if (c >= 'a' && c <= 'f')
+        code |= static_cast<unsigned>(c - 'a' + 10);
+      else if (c >= 'A' && c <= 'F')
+        code |= static_cast<unsigned>(c - 'A' + 10);
+      else
+        return fail("Invalid \\u escape");
+    }
+    return true;
+  };
+
+  static void appendUtf8(string& out, unsigned code) {
+    if (code < 0x80) {
+      out += static_cast<char>(code);
+    } else if (code < 0x800) {
+      out += static_cast<char>(0xC0 | (code >> 6));
+      out += static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+      out += static_cast<char>(0xE0 | (code >> 12));
+      out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+      out += static_cast<char>(0xF0 | (code >> 18));
+      out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+      out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+  };
+
+  auto parseString(string& out) -> bool {
+    ++m_pos;  // '"'
+    while (true) {
+      // Copy everything up to the next quote or escape in one go
+      const char* run = m_pos;
+      while (m_pos < m_end && *m_pos != '"' && *m_pos != '\\') {
+        if (static_cast<unsigned char>(*m_pos) < 0x20) return fail("Control character in string");
+        ++m_pos;
+      }
+      out.append(run, m_pos);
+
+      if (m_pos == m_end) return fail("Unterminated string");
+      if (*m_pos++ == '"') return true;
+
+      if (m_pos == m_end) return fail("Unterminated string");
+      switch (*m_pos++) {
+        case '"': out += '"'; break;
+        case '\\': out += '\\'; break;
+        case '/': out += '/'; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'n': out += '\n'; break;
+        case 'r': out += '\r'; break;
+        case 't': out += '\t'; break;
+        case 'u': {
+          unsigned code = 0;
+          if (!parseHex4(code)) return false;
+          // Characters outside the BMP come as a pair of surrogates
+          if (code >= 0xD800 && code < 0xDC00 && consume("\\u")) {
+            unsigned low = 0;
+            if (!parseHex4(low)) return false;
+            if (low < 0xDC00 || low >= 0xE000) return fail("Invalid surrogate pair");
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+          }
+          appendUtf8(out, code);
+          break;
+        }
+        default:
+          return fail("Invalid escape in string");
+      }
+    }
+  };
+
+  auto parseNumber(double& number) -> bool {
+    const char* start = m_pos;
+    if (m_pos < m_end && *m_pos == '-') ++m_pos;
+    const char* digits = m_pos;
+    while (m_pos < m_end && ((*m_pos >= '0' && *m_pos <= '9') || *m_pos == '.' || *m_pos == 'e' || *m_pos == 'E' ||
+                             *m_pos == '+' || *m_pos == '-'))
+      ++m_pos;
+    if (m_pos == digits || *digits < '0' || *digits > '9') return fail("Unexpected character");
+
+    // strtod needs a terminated copy, as the document may not be
+    const string text(start, m_pos);
+    char*        parsed = nullptr;
+    number              = strtod(text.c_str(), &parsed);
+    return parsed == text.c_str() + text.size() || fail("Invalid number");
+  };
+};
+};  // namespace
+
+auto parseJson(const char* begin, const char* end, JsonValue& value, string& error) -> bool {
+  value = JsonValue();
+  return JsonParser(begin, end).parseDocument(value, error);
+};
+};  // namespace flint
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace flint {
+
+/*
+ * A parsed JSON document, or any value inside of one
+ */
+struct JsonValue {
+  enum Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT };
+
+  Type                                           type{NUL};
+  bool                                           boolean{false};
+  double                                         number{0};
+  std::string                                    text;
+  std::vector<JsonValue>                         array;
+  std::vector<std::pair<std::string, JsonValue>> object;  // members in document order
+
+  /**
+   * Looks up a member of an object
+   *
+   * @param key
+   *        The name of the member
+   * @return
+   *        Returns the member's value, or nullptr if this is not an object
+   *        or has no such member
+   */
+  auto find(const std::string& key) const -> const JsonValue*;
+};
+
+/**
+ * Parses a JSON document (RFC 8259)
+ *
+ * @param begin
+ *        The start of the document
+ * @param end
+ *        The end of the document
+ * @param value
+ *        Filled with the document's top level value
+ * @param error
+ *        Filled with a description of the first syntax error, including
+ *        its line, if there is one
+ * @return
+ *        Returns false if the document is not valid JSON
+ */
+auto parseJson(const char* begin, const char* end, JsonValue& value, std::string& error) -> bool;
+};  // namespace flint
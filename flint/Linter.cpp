@@ -0,0 +1,148 @@
+#include "Linter.hpp"
+
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "Cache.hpp"
+#include "Checks.hpp"
+#include "FileLists.hpp"
+#include "FileCategories.hpp"
+#include "Ignored.hpp"
+#include "Options.hpp"
+#include "Registry.hpp"
+#include "Stats.hpp"
+
+using namespace std;
+
+namespace flint {
+
+auto lintFile(const string& path, LintResult& result, ResultCache* cache) -> bool {
+  CacheProbe probe;
+  if (cache && cache->lookup(path, probe, result)) return true;
+
+  // Listed files are not checked up front, so this is where a missing one shows
+  FileBuffer contents;
+  if (!contents.load(path)) {
+    fprintf(stderr, "Cannot read file '%s'.\n\n", path.c_str());
+    return false;
+  }
+  if (cache) return lintThroughCache(*cache, probe, contents.begin(), contents.end(), result);
+  return lintContents(path, contents.begin(), contents.end(), result);
+};
+
+auto lintThroughCache(ResultCache& cache, CacheProbe& probe, const char* begin, const char* end, LintResult& result)
+    -> bool {
+  if (cache.lookup(probe, begin, end, result)) return true;
+  if (!lintContents(probe.path, begin, end, result)) return false;
+  cache.store(probe, result);
+  return true;
+};
+
+namespace {
+/*
+ * What a worker thread keeps from one file to the next. Vectors and
+ * strings are cleared but not freed, so once a worker has seen a few files
+ * linting allocates little more than the problems it reports.
+ */
+struct Scratch {
+  TokenList  tokens;
+  ScopeTree  scopes;
+  string     withoutIgnored;
+  double     tokensPerByte{0};               // in the last file, to size the next one's tokens up front
+  Dispatcher checks[NUM_FILE_CATEGORIES];  // set up on the first file of each category, from the Plan
+};
+thread_local Scratch t_scratch;
+
+/**
+ * Tokenizes the text and runs the enabled checks on it, see lintContents()
+ */
+auto checkContents(const string& path, const char* begin, const char* end, LintResult& result) -> bool {
+  // Remove code that occurs in pairs of
+  // "// %flint: pause" & "// %flint: resume"
+  Scratch& scratch = t_scratch;
+  if (removeIgnoredCode(begin, end, path, scratch.withoutIgnored)) {
+    begin = scratch.withoutIgnored.data();
+    end   = scratch.withoutIgnored.data() + scratch.withoutIgnored.size();
+  }
+
+  try {
+    unique_ptr<ErrorFile> file{new ErrorFile((Options.VERBOSE ? path : getFileName(path)))};
+    ErrorFile&            errorFile = *file;
+
+    TokenList&   tokens = scratch.tokens;
+    ScopeTree&   scopes = scratch.scopes;
+    const size_t bytes  = max<size_t>(distance(begin, end), 1);
+    tokens.reserve(static_cast<size_t>(scratch.tokensPerByte * 1.125 * static_cast<double>(bytes)));
+    result.loc            = tokenize(begin, end, path, tokens, errorFile);
+    scratch.tokensPerByte = static_cast<double>(tokens.size()) / static_cast<double>(bytes);
+    scopes.build(tokens);
+
+    const FileCategory category = getFileCategory(path);
+    Dispatcher&        checks   = scratch.checks[category];
+    if (checks.empty()) Plan.addTo(category, checks);
+    checks.run(errorFile, path, tokens, scopes);
+
+    result.file = move(file);
+    return true;
+  }
+  catch (exception const& e) {
+    fprintf(stderr, "Exception thrown during checks on %s.\n%s\n\n", path.c_str(), e.what());
+  }
+  return false;
+};
+};  // namespace
+
+auto lintContents(const string& path, const char* begin, const char* end, LintResult& result) -> bool {
+  ++Stats.filesLinted;
+
+  const size_t allocations = threadAllocations();
+  const bool   linted      = checkContents(path, begin, end, result);
+  Stats.lintAllocations += threadAllocations() - allocations;
+  return linted;
+};
+
+void lintFiles(Walker& walker, size_t jobs, ErrorReport& errors, size_t& loc, ResultCache* cache,
+               const ChangedLines* changedLines) {
+  mutex  sourceMutex, reportMutex;
+  size_t nextTaken = 0, nextReported = 0;
+
+  // Results that finished ahead of an earlier file, keyed by walk order
+  map<size_t, LintResult> pending;
+
+  auto worker = [&]() {
+    string path;
+    while (true) {
+      size_t seq;
+      {
+        lock_guard<mutex> lock(sourceMutex);
+        if (!walker.next(path)) return;
+        seq = nextTaken++;
+      }
+
+      LintResult result;
+      lintFile(path, result, cache);
+      if (changedLines) changedLines->filter(path, result);
+
+      lock_guard<mutex> lock(reportMutex);
+      pending.emplace(seq, move(result));
+      for (auto it = pending.begin(); it != pending.end() && it->first == nextReported; ++nextReported) {
+        // Lines are counted even if the checks on a tokenized file later threw
+        loc += it->second.loc;
+        if (it->second.file) errors.addFile(move(*it->second.file));
+        it = pending.erase(it);
+      }
+    }
+  };
+
+  if (jobs <= 1) {
+    worker();
+    return;
+  }
+
+  vector<thread> pool;
+  pool.reserve(jobs);
+  for (size_t i = 0; i < jobs; ++i) pool.emplace_back(worker);
+  for (auto& t: pool) t.join();
+};
+};  // namespace flint
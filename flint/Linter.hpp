@@ -0,0 +1,98 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ErrorReport.hpp"
+#include "Walker.hpp"
+
+namespace flint {
+
+class ChangedLines;
+class ResultCache;
+struct CacheProbe;
+
+/*
+ * Everything learned from linting a single file
+ */
+struct LintResult {
+  std::unique_ptr<ErrorFile> file;
+  size_t                     loc{0};
+};
+
+/**
+ * Reads, tokenizes and runs every enabled check on a single file
+ *
+ * @param path
+ *        The path of the file to lint
+ * @param result
+ *        Filled with the file's errors and estimated lines of code
+ * @param cache
+ *        The result cache to consult and fill, or nullptr
+ * @return
+ *        Returns false if the file could not be read or the checks threw
+ */
+auto lintFile(const std::string& path, LintResult& result, ResultCache* cache = nullptr) -> bool;
+
+/**
+ * Runs every enabled check on a file that has already been read
+ *
+ * @param path
+ *        The path the file was read from
+ * @param begin
+ *        The start of the file's contents
+ * @param end
+ *        The end of the file's contents, which must point at a '\0'
+ * @param result
+ *        Filled with the file's errors and estimated lines of code
+ * @return
+ *        Returns false if the checks threw
+ */
+auto lintContents(const std::string& path, const char* begin, const char* end, LintResult& result) -> bool;
+
+/**
+ * Like lintContents(), but reuses the cached results for the same
+ * contents if there are any, and caches the results otherwise
+ *
+ * @param cache
+ *        The result cache to consult and fill
+ * @param probe
+ *        What the cache learned about the file before it was read
+ * @param begin
+ *        The start of the file's contents
+ * @param end
+ *        The end of the file's contents, which must point at a '\0'
+ * @param result
+ *        Filled with the file's errors and estimated lines of code
+ * @return
+ *        Returns false if the checks threw
+ */
+auto lintThroughCache(ResultCache& cache, CacheProbe& probe, const char* begin, const char* end, LintResult& result)
+    -> bool;
+
+/**
+ * Lints the files found by a walker using a pool of worker threads
+ *
+ * Files are handed out to the workers in walk order as soon as the walker
+ * finds them, and the results are always added to the report in that same
+ * order no matter which worker finishes first, so the report does not
+ * depend on the thread count.
+ *
+ * @param walker
+ *        The source of files to lint
+ * @param jobs
+ *        The number of worker threads to use
+ * @param errors
+ *        The report to add each file's errors to
+ * @param loc
+ *        Reference to a var to count the estimated number
+ *        of lines linted
+ * @param cache
+ *        The result cache to consult and fill, or nullptr
+ * @param changedLines
+ *        If not null, only errors on these lines are reported
+ */
+void lintFiles(Walker& walker, size_t jobs, ErrorReport& errors, size_t& loc, ResultCache* cache = nullptr,
+               const ChangedLines* changedLines = nullptr);
+};  // namespace flint
@@ -1,137 +1,79 @@
 #include <iostream>
+#include <memory>
 #include <string>
 
-#include "Checks.hpp"
+#include "Cache.hpp"
+#include "Config.hpp"
 #include "ErrorReport.hpp"
-#include "FileCategories.hpp"
-#include "Ignored.hpp"
+#include "FileLists.hpp"
+#include "Linter.hpp"
 #include "Options.hpp"
+#include "Pipeline.hpp"
+#include "Registry.hpp"
+#include "Stats.hpp"
+#include "Walker.hpp"
 
 using namespace std;
 using namespace flint;
 
 /**
- * Run lint on the given path
- *
- * @param errors
- *        An object to hold the error details
- * @param path
- *        The path to lint
- * @param loc
- *        Reference to a var to count the estimated number
- *        of lines linted
- * @param depth
- *        Tracks the recursion depth
- * @return
- *        Returns the number of errors found
+ * Program entry point
  */
-void checkEntry(ErrorReport& errors, const string& path, size_t& loc, size_t depth = 0) {
-  const auto fsType = fsObjectExists(path);
-  if (fsType == FSType::NO_ACCESS) {
-    if (0 == depth) fprintf(stderr, "Explicitly requested file/path '%s' does not exist.\n\n", path.c_str());
-    return;
-  }
-
-  if (fsType == FSType::IS_DIR) {
-    if ((!Options.RECURSIVE && depth > 0) || fsContainsNoLint(path)) return;
-
-    // For each object in the directory
-    vector<string> dirs;
-    if (!fsGetDirContents(path, dirs)) return;
+auto main(int argc, char* argv[]) -> int {
+  // Parse commandline flags
+  vector<string> paths;
+  parseArgs(argc, argv, paths);
 
-    for (const auto& dir: dirs) checkEntry(errors, dir, loc, depth + 1);
+  // Banned identifiers are interned, so this comes before any file is tokenized
+  if (!Options.CONFIG.empty() && !Config.load(Options.CONFIG)) return 1;
 
-    return;
+  // Which checks run on each category of file is only decided once
+  if (!Plan.build()) return 1;
+  if (Options.LIST_CHECKS) {
+    printChecks();
+    return 0;
   }
 
-  if (getFileCategory(path) == FileCategory::UNKNOWN) return;
-
-  string fileContents;
-  if (!getFileContents(path, fileContents)) return;
-
-  // Remove code that occurs in pairs of
-  // "// %flint: pause" & "// %flint: resume"
-  fileContents = removeIgnoredCode(fileContents, path);
-
-  try {
-    ErrorFile errorFile((Options.VERBOSE ? path : getFileName(path)));
-
-    vector<Token>  tokens;
-    vector<size_t> structures;
-    loc += tokenize(fileContents, path, tokens, structures, errorFile);
-
-    // Checks which note Errors
-    checkBlacklistedIdentifiers(errorFile, path, tokens);
-    checkInitializeFromItself(errorFile, path, tokens);
-    checkIfEndifBalance(errorFile, path, tokens);
-    checkMemset(errorFile, path, tokens);
-    checkIncludeAssociatedHeader(errorFile, path, tokens);
-    checkIncludeGuard(errorFile, path, tokens);
-    checkInlHeaderInclusions(errorFile, path, tokens);
-
-    if (!Options.CMODE) {
-      checkMutexHolderHasName(errorFile, path, tokens);
-      checkConstructors(errorFile, path, tokens, structures);
-      checkCatchByReference(errorFile, path, tokens);
-      checkThrowsHeapException(errorFile, path, tokens);
-      checkUniquePtrUsage(errorFile, path, tokens);
-    }
-
-    // Checks which note Warnings
-    if (Options.LEVEL >= Lint::WARNING) {
-      checkBlacklistedSequences(errorFile, path, tokens);
-      checkDefinedNames(errorFile, path, tokens);
-      checkDeprecatedIncludes(errorFile, path, tokens);
-      checkNamespaceScopedStatics(errorFile, path, tokens);
-      checkUsingNamespaceDirectives(errorFile, path, tokens);
-
-      if (!Options.CMODE) {
-        checkSmartPtrUsage(errorFile, path, tokens);
-        checkImplicitCast(errorFile, path, tokens, structures);
-        checkProtectedInheritance(errorFile, path, tokens, structures);
-        checkExceptionInheritance(errorFile, path, tokens, structures);
-        checkVirtualDestructors(errorFile, path, tokens, structures);
+  // Files from lists are linted as they are, without searching any directories
+  vector<string> listed;
+  if (!Options.FILES_FROM.empty() && !readFileList(Options.FILES_FROM, listed)) return 1;
+  if (!Options.COMPILE_COMMANDS.empty() && !readCompileCommands(Options.COMPILE_COMMANDS, listed)) return 1;
 
-        checkThrowSpecification(errorFile, path, tokens, structures);
-      }
-    }
-
-#if 0
-    // Checks which note Advice
-    if (Options.LEVEL >= Lint::ADVICE) {
-      // Deprecated due to too many false positives
-      // checkIncrementers(errorFile, path, tokens);
+  // With --since, git says which files to lint and the paths only narrow that down
+  ChangedLines changedLines;
+  if (!Options.SINCE.empty()) {
+    if (!gitChangedFiles(Options.SINCE, paths, listed, Options.DIFF_LINES_ONLY ? &changedLines : nullptr)) return 1;
+    paths.clear();
+  }
+  const ChangedLines* const lineFilter = Options.DIFF_LINES_ONLY ? &changedLines : nullptr;
 
-      if (!Options.CMODE) {
-        // Merged into banned identifiers
-        // checkUpcaseNull(errorFile, path, tokens);
-      }
-    }
-#endif
+  // Directories are listed in the background while the files already found are linted
+  const size_t jobs = Options.JOBS;
+  Walker       walker(paths, jobs > 1 ? jobs : 0, listed);
 
-    errors.addFile(move(errorFile));
-  }
-  catch (exception const& e) {
-    fprintf(stderr, "Exception thrown during checks on %s.\n%s\n\n", path.c_str(), e.what());
+  // Results from earlier runs are reused for files that have not changed
+  unique_ptr<ResultCache> cache;
+  if (!Options.CACHE_DIR.empty()) {
+    cache.reset(new ResultCache(Options.CACHE_DIR));
+    if (!cache->usable()) cache.reset();
   }
-};
-
-/**
- * Program entry point
- */
-auto main(int argc, char* argv[]) -> int {
-  // Parse commandline flags
-  vector<string> paths;
-  parseArgs(argc, argv, paths);
 
   size_t totalLOC = 0;
   // Check each file
   ErrorReport errors;
-  for (auto& path: paths) checkEntry(errors, path, totalLOC);
-
-  // Print summary
-  errors.print();
+  if (Options.PIPELINE) {
+    // Prints each file as soon as it and all files before it are linted
+    lintPipelined(walker, jobs, errors, totalLOC, cache.get(), lineFilter);
+  } else {
+    lintFiles(walker, jobs, errors, totalLOC, cache.get(), lineFilter);
+
+    // Print summary
+    errors.print();
+  }
   if (!Options.JSON) cout << endl << "Estimated Lines of Code: " << to_string(totalLOC) << endl;
+  if (cache) cache->printSummary();
+  if (Options.PRINT_IGNORED_STATS) printIgnoredStats();
+  if (Options.STATS) printStats();
 
 #ifdef _DEBUG
   // Stop visual studio from closing the window...
@@ -1,7 +1,10 @@
 #include "Options.hpp"
 
+#include <cctype>
 #include <unordered_map>
 
+#include "Polyfill.hpp"
+
 using namespace std;
 
 namespace flint {
@@ -21,6 +24,20 @@ void __attribute__((noreturn)) printHelp() {
          "\t\t\t          1 : Errors only\n"
          "\t\t\t          2 : Errors & Warnings\n"
          "\t\t\t          3 : All feedback\n"
+         "\t--jobs [def=CPUs]\t: Number of files to lint in parallel.\n"
+         "\t--pipeline\t\t: Read, lint and print files in overlapping stages.\n"
+         "\t--cache [dir]\t\t: Reuse the results for unchanged files.\n"
+         "\t--since [rev]\t\t: Only lint files changed since a git revision.\n"
+         "\t--diff-lines-only\t: With --since, only report changed lines.\n"
+         "\t--files-from [file]\t: Also lint the files listed in a file, or - for stdin.\n"
+         "\t--compile-commands [file]: Also lint the files in a compile_commands.json.\n"
+         "\t--config [file]\t\t: Add the banned identifiers, sequences and includes of a JSON file.\n"
+         "\t--enable [checks]\t: Only run the named checks, separated by commas.\n"
+         "\t--disable [checks]\t: Don't run the named checks, separated by commas.\n"
+         "\t--list-checks\t\t: List the checks and whether they would run.\n"
+         "\t@file\t\t\t: Read more arguments from a file.\n"
+         "\t--print-ignored-stats\t: Print what .flintignore files left out.\n"
+         "\t--stats\t\t\t: Print run statistics to stderr.\n"
          "\t-h, --help\t\t: Print usage.\n\n");
 #ifdef _DEBUG
   // Stop visual studio from closing the window...
@@ -29,6 +46,62 @@ void __attribute__((noreturn)) printHelp() {
   exit(1);
 };
 
+// Response files may name further response files, but not forever
+static constexpr int kMaxResponseDepth = 16;
+
+/**
+ * Splits a response file into arguments the way GCC does: on whitespace,
+ * except inside single or double quotes or after a backslash. Arguments
+ * starting with '@' name further response files, which are expanded too.
+ *
+ * @param path
+ *        The response file to read
+ * @param args
+ *        The arguments read are appended to this
+ * @param depth
+ *        How many response files deep this one is
+ */
+static void readResponseFile(const string& path, vector<string>& args, int depth) {
+  FileBuffer contents;
+  if (depth > kMaxResponseDepth || !contents.load(path)) {
+    printf("Cannot read response file: %s\n\n", path.c_str());
+    printHelp();
+  }
+
+  string arg;
+  bool   inArg = false;
+  char   quote = '\0';
+  for (const char* c = contents.begin(); c != contents.end(); ++c) {
+    if (*c == '\\' && c + 1 != contents.end() && quote != '\'') {
+      arg += *++c;
+      inArg = true;
+    } else if (quote != '\0') {
+      if (*c == quote)
+        quote = '\0';
+      else
+        arg += *c;
+    } else if (*c == '\'' || *c == '"') {
+      quote = *c;
+      inArg = true;
+    } else if (isspace(static_cast<unsigned char>(*c))) {
+      if (!inArg) continue;
+      if (arg[0] == '@' && arg.size() > 1)
+        readResponseFile(arg.substr(1), args, depth + 1);
+      else
+        args.push_back(move(arg));
+      arg.clear();
+      inArg = false;
+    } else {
+      arg += *c;
+      inArg = true;
+    }
+  }
+  if (inArg && !arg.empty() && arg[0] == '@' && arg.size() > 1)
+    readResponseFile(arg.substr(1), args, depth + 1);
+  else if (inArg)
+    args.push_back(move(arg));
+};
+
 /**
  * Given an argument count and list, parses the arguments
  * and sets the global options as desired
@@ -44,7 +117,7 @@ void parseArgs(int argc, char* argv[], vector<string>& paths) {
   bool HELP{false}, l1{false}, l2{false}, l3{false};
 
   // TODO: C++17 std::variant
-  enum ArgType { BOOL, INT };
+  enum ArgType { BOOL, INT, COUNT, STRING };
   struct Arg {
     bool          set;
     const ArgType type;
@@ -62,6 +135,19 @@ void parseArgs(int argc, char* argv[], vector<string>& paths) {
   Arg argL1       {false, ArgType::BOOL, &l1};
   Arg argL2       {false, ArgType::BOOL, &l2};
   Arg argL3       {false, ArgType::BOOL, &l3};
+  Arg argJobs     {false, ArgType::COUNT, &Options.JOBS};
+  Arg argPipeline {false, ArgType::BOOL, &Options.PIPELINE};
+  Arg argStats    {false, ArgType::BOOL, &Options.STATS};
+  Arg argCache    {false, ArgType::STRING, &Options.CACHE_DIR};
+  Arg argSince    {false, ArgType::STRING, &Options.SINCE};
+  Arg argDiffLines{false, ArgType::BOOL, &Options.DIFF_LINES_ONLY};
+  Arg argFilesFrom{false, ArgType::STRING, &Options.FILES_FROM};
+  Arg argCompileDB{false, ArgType::STRING, &Options.COMPILE_COMMANDS};
+  Arg argConfig   {false, ArgType::STRING, &Options.CONFIG};
+  Arg argIgnored  {false, ArgType::BOOL, &Options.PRINT_IGNORED_STATS};
+  Arg argEnable   {false, ArgType::STRING, &Options.ENABLE};
+  Arg argDisable  {false, ArgType::STRING, &Options.DISABLE};
+  Arg argList     {false, ArgType::BOOL, &Options.LIST_CHECKS};
 
   static const unordered_map<string, Arg &> params {
     { "-h", argHelp },
@@ -83,15 +169,40 @@ void parseArgs(int argc, char* argv[], vector<string>& paths) {
     { "-l3", argL3 },
 
     { "-v", argVerbose },
-    { "--verbose", argVerbose }
+    { "--verbose", argVerbose },
+
+    { "--jobs", argJobs },
+    { "--pipeline", argPipeline },
+    { "--stats", argStats },
+    { "--cache", argCache },
+    { "--since", argSince },
+    { "--diff-lines-only", argDiffLines },
+    { "--files-from", argFilesFrom },
+    { "--compile-commands", argCompileDB },
+    { "--config", argConfig },
+    { "--print-ignored-stats", argIgnored },
+    { "--enable", argEnable },
+    { "--disable", argDisable },
+    { "--list-checks", argList }
   };
   // clang-format on
+  // Arguments of the form @file are replaced by the arguments in that file
+  vector<string> args;
+  for (int i = 1; i < argc; ++i) {
+    if (argv[i][0] == '@' && argv[i][1] != '\0')
+      readResponseFile(argv[i] + 1, args, 1);
+    else
+      args.emplace_back(argv[i]);
+  }
+  const size_t argCount = args.size();
+
   // Loop over the given argument list
   // NOTE: If type is INT, it will subtract 1 from the value when storing
-  for (int i = 1; i < argc; ++i) {
+  //       If type is COUNT, it must be a positive number and is stored as-is
+  for (size_t i = 0; i < argCount; ++i) {
     // If the current argument is in the map
     // then set its value to true
-    auto const it = params.find(string(argv[i]));
+    auto const it = params.find(args[i]);
     if (it != params.end()) {
       auto const param_str = it->first.c_str();
       auto       val       = it->second;
@@ -102,18 +213,33 @@ void parseArgs(int argc, char* argv[], vector<string>& paths) {
       val.set = true;
       switch (val.type) {
         case ArgType::INT:
-          if (++i >= argc) {
+          if (++i >= argCount) {
             printf("Missing (int) value for parameter: %s\n\n", param_str);
             printHelp();
           }
-          *(static_cast<int*>(val.ptr)) = atoi(argv[i]) - 1;
+          *(static_cast<int*>(val.ptr)) = atoi(args[i].c_str()) - 1;
+          continue;
+        case ArgType::COUNT:
+          if (++i >= argCount || atoi(args[i].c_str()) < 1) {
+            printf("Missing (positive int) value for parameter: %s\n\n", param_str);
+            printHelp();
+          }
+          *(static_cast<int*>(val.ptr)) = atoi(args[i].c_str());
+          continue;
+        case ArgType::STRING:
+          if (++i >= argCount || args[i].empty()) {
+            printf("Missing (string) value for parameter: %s\n\n", param_str);
+            printHelp();
+          }
+          *(static_cast<string*>(val.ptr)) = args[i];
           continue;
         default:  // Bool
           *(static_cast<bool*>(val.ptr)) = true;
       }
     } else {
       // Push another path onto the lint list
-      string p{argv[i]};
+      string p{move(args[i])};
+      if (p.empty()) continue;
       if (p.back() == '/' || p.back() == '\\') p.erase(p.end() - 1, p.end());
       // printf("Pushing %s\n", p.c_str());
       paths.push_back(move(p));
@@ -138,6 +264,19 @@ void parseArgs(int argc, char* argv[], vector<string>& paths) {
   Options.LEVEL = std::min(Options.LEVEL, static_cast<int>(Lint::ADVICE));
   Options.LEVEL = std::max(Options.LEVEL, static_cast<int>(Lint::ERROR));
 
-  if (paths.empty()) paths.emplace_back(".");
+  if (Options.DIFF_LINES_ONLY && Options.SINCE.empty()) {
+    printf("--diff-lines-only requires --since\n\n");
+    printHelp();
+  }
+  // Revisions starting with a dash would be taken for git options
+  if (!Options.SINCE.empty() && Options.SINCE[0] == '-') {
+    printf("Invalid revision for --since: %s\n\n", Options.SINCE.c_str());
+    printHelp();
+  }
+
+  if (Options.JOBS == 0) Options.JOBS = static_cast<int>(getUsableCPUs());
+
+  // Only fall back on the current directory if nothing else says what to lint
+  if (paths.empty() && Options.FILES_FROM.empty() && Options.COMPILE_COMMANDS.empty()) paths.emplace_back(".");
 };
 };  // namespace flint
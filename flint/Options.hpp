@@ -13,6 +13,20 @@ struct OptionsInfo {
   bool JSON{false};
   bool VERBOSE{false};
   int  LEVEL{Lint::ADVICE};
+  bool STATS{false};
+  bool PIPELINE{false};
+  int  JOBS{0};  // 0 means one per usable CPU
+
+  std::string CACHE_DIR;  // empty means no result cache
+  std::string SINCE;      // empty means lint the given paths as they are
+  bool        DIFF_LINES_ONLY{false};
+  std::string FILES_FROM;        // "-" means stdin
+  std::string COMPILE_COMMANDS;  // path of a compile_commands.json
+  std::string CONFIG;            // path of a JSON file of banned identifiers, sequences and includes
+  bool        PRINT_IGNORED_STATS{false};
+  std::string ENABLE;   // comma-separated check names; empty means all of them
+  std::string DISABLE;  // comma-separated check names
+  bool        LIST_CHECKS{false};
 };
 extern OptionsInfo Options;
 
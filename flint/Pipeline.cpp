@@ -0,0 +1,143 @@
+#include "Pipeline.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#include "BoundedQueue.hpp"
+#include "Linter.hpp"
+#include "Stats.hpp"
+
+using namespace std;
+
+namespace flint {
+
+namespace {
+// A file on its way from the reader to a lint thread
+struct ReadItem {
+  size_t     seq{0};
+  string     path;
+  FileBuffer contents;
+  bool       ok{false};
+  CacheProbe probe;
+  bool       cached{false};  // result already came from the cache
+  LintResult result;
+};
+
+// A linted file on its way to the reporter
+struct DoneItem {
+  size_t     seq{0};
+  LintResult result;
+};
+};  // namespace
+
+void lintPipelined(Walker& walker, size_t jobs, ErrorReport& errors, size_t& loc, ResultCache* cache,
+                   const ChangedLines* changedLines) {
+  const size_t linters = max<size_t>(jobs, 1);
+  // Enough slack in each queue that no stage waits on a single slow file
+  BoundedQueue<ReadItem> readQueue(2 * linters);
+  BoundedQueue<DoneItem> doneQueue(2 * linters);
+
+  // Files that finish early wait for the ones before them to be reported. To
+  // bound that backlog, the reader stays within a window of the report.
+  const size_t       window = 6 * linters;
+  mutex              windowMutex;
+  condition_variable windowMoved;
+  size_t             reported = 0;  // guarded by windowMutex
+  size_t             windowStalls = 0;
+  double             windowStallSecs = 0;
+
+  thread reader([&] {
+    string path;
+    for (size_t seq = 0; walker.next(path); ++seq) {
+      {
+        unique_lock<mutex> lock(windowMutex);
+        if (seq >= reported + window) {
+          const auto start = chrono::steady_clock::now();
+          windowMoved.wait(lock, [&] { return seq < reported + window; });
+          ++windowStalls;
+          windowStallSecs += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        }
+      }
+
+      ReadItem item;
+      item.seq    = seq;
+      item.cached = cache && cache->lookup(path, item.probe, item.result);
+      item.ok     = item.cached || item.contents.load(path);
+      item.path   = move(path);
+      readQueue.push(move(item));
+    }
+    readQueue.close();
+  });
+
+  atomic<size_t> running{linters};
+  vector<thread> pool;
+  pool.reserve(linters);
+  for (size_t i = 0; i < linters; ++i) {
+    pool.emplace_back([&] {
+      ReadItem item;
+      while (readQueue.pop(item)) {
+        DoneItem done;
+        done.seq = item.seq;
+        if (item.cached)
+          done.result = move(item.result);
+        else if (item.ok && cache)
+          lintThroughCache(*cache, item.probe, item.contents.begin(), item.contents.end(), done.result);
+        else if (item.ok)
+          lintContents(item.path, item.contents.begin(), item.contents.end(), done.result);
+        else
+          fprintf(stderr, "Cannot read file '%s'.\n\n", item.path.c_str());
+        if (changedLines) changedLines->filter(item.path, done.result);
+        // Hand the read buffer back to the pool right away
+        item.contents.release();
+        doneQueue.push(move(done));
+      }
+      // The last lint thread out tells the reporter there is nothing more to come
+      if (--running == 0) doneQueue.close();
+    });
+  }
+
+  // The reporter runs right here, printing files in walk order
+  ostringstream jsonFiles;
+  ostream&      out = Options.JSON ? static_cast<ostream&>(jsonFiles) : cout;
+
+  map<size_t, LintResult> pending;
+  size_t                  nextReported = 0, printed = 0;
+  DoneItem                done;
+  while (doneQueue.pop(done)) {
+    pending.emplace(done.seq, move(done.result));
+    for (auto it = pending.begin(); it != pending.end() && it->first == nextReported; ++nextReported) {
+      // Lines are counted even if the checks on a tokenized file later threw
+      loc += it->second.loc;
+      if (it->second.file) {
+        errors.countFile(*it->second.file);
+        ErrorReport::printFile(*it->second.file, printed++, out);
+      }
+      it = pending.erase(it);
+    }
+
+    {
+      lock_guard<mutex> lock(windowMutex);
+      reported = nextReported;
+    }
+    windowMoved.notify_one();
+  }
+
+  reader.join();
+  for (auto& t: pool) t.join();
+
+  errors.printHeader();
+  cout << jsonFiles.str();
+  errors.printFooter();
+
+  Stats.pipelined       = true;
+  Stats.lintThreads     = linters;
+  Stats.readQueue       = readQueue.stats();
+  Stats.doneQueue       = doneQueue.stats();
+  Stats.windowStalls    = windowStalls;
+  Stats.windowStallSecs = windowStallSecs;
+};
+};  // namespace flint
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Cache.hpp"
+#include "ErrorReport.hpp"
+#include "FileLists.hpp"
+#include "Walker.hpp"
+
+namespace flint {
+
+/**
+ * Lints and prints the files found by a walker as a three stage pipeline
+ *
+ * A reader thread loads files from disk, a pool of lint threads tokenizes and
+ * checks them, and the calling thread prints each file's errors as soon as
+ * it and every file before it are done. The stages are joined by bounded
+ * queues, and the reader never gets more than a fixed number of files ahead
+ * of the report, so memory use does not grow with the size of the tree.
+ * The output is identical to linting with lintFiles() and printing the
+ * report afterwards; JSON totals come first, so in JSON mode the files are
+ * formatted as they arrive but only written out at the end.
+ *
+ * @param walker
+ *        The source of files to lint
+ * @param jobs
+ *        The number of lint threads to use
+ * @param errors
+ *        The report to count each file's errors into
+ * @param loc
+ *        Reference to a var to count the estimated number
+ *        of lines linted
+ * @param cache
+ *        The result cache to consult and fill, or nullptr; files whose
+ *        stat data is unchanged are then passed on without being read
+ * @param changedLines
+ *        If not null, only errors on these lines are reported
+ */
+void lintPipelined(Walker& walker, size_t jobs, ErrorReport& errors, size_t& loc, ResultCache* cache = nullptr,
+                   const ChangedLines* changedLines = nullptr);
+};  // namespace flint
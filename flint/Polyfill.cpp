@@ -3,14 +3,28 @@
 #include <sys/stat.h>
 
 #include <algorithm>
-#include <fstream>
-#include <sstream>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "Stats.hpp"
 
 // Conditional includes for folder traversal
 #ifdef _WIN32
+#include <direct.h>
 #include <windows.h>
 #else
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Conditional includes for CPU affinity
+#ifdef __linux__
+#include <sched.h>
 #endif
 
 using namespace std;
@@ -28,6 +42,24 @@ inline auto fs_isnot_git(const T& file) -> bool {
   return file.compare(".git");
 }
 
+/**
+ * Classifies a file mode as returned by stat()
+ *
+ * @param mode
+ *        The st_mode to classify
+ * @return
+ *        Returns a flag representing what the mode describes
+ */
+static auto fsTypeOfMode(unsigned int mode) -> FSType {
+  if (mode & S_IFDIR)
+    // Is a Directory
+    return FSType::IS_DIR;
+  if (mode & S_IFREG)
+    // Is a File
+    return FSType::IS_FILE;
+  return FSType::NO_ACCESS;
+};
+
 /**
  * Checks if a given path is a file or directory
  *
@@ -38,98 +70,515 @@ inline auto fs_isnot_git(const T& file) -> bool {
  */
 auto fsObjectExists(const string& path) -> FSType {
   struct stat info;
+  ++Stats.statCalls;
   if (stat(path.c_str(), &info))
     // Cannot Access
     return FSType::NO_ACCESS;
-  if (info.st_mode & S_IFDIR)
-    // Is a Directory
-    return FSType::IS_DIR;
-  if (info.st_mode & S_IFREG)
-    // Is a File
-    return FSType::IS_FILE;
-  return FSType::NO_ACCESS;
+  return fsTypeOfMode(info.st_mode);
 };
 
 /**
- * Checks if a given path contains a .nolint file
+ * Fetches the size of a file
  *
  * @param path
- *        The path to test
+ *        The file to measure
  * @return
- *        Returns a bool of whether a .nolint file was found or not
+ *        Returns the size in bytes, or 0 if it could not be accessed
  */
-auto fsContainsNoLint(const string& path) -> bool {
-  const string fileName{path + FS_SEP + ".nolint"};
-  return fsObjectExists(fileName) == FSType::IS_FILE;
+auto fsFileSize(const string& path) -> uint64_t {
+  struct stat info;
+  ++Stats.statCalls;
+  if (stat(path.c_str(), &info)) return 0;
+  return static_cast<uint64_t>(info.st_size);
 };
 
 /**
- * Parses a directory and returns a list of its contents
+ * Lists a directory along with the type of each entry
+ *
+ * On POSIX systems the type comes straight from the directory listing when
+ * the file system provides it, and otherwise from an fstatat() relative to
+ * the open directory, so no entry is ever looked up again by its full path.
+ * A .nolint file is spotted in the same pass.
  *
  * @param path
- *        The path to search
- * @param dirs
- *        A vector to fill with objects
+ *        The directory to list
+ * @param entries
+ *        A vector to fill with the entries (without ".", ".." and ".git")
+ * @param noLint
+ *        Set to whether the directory contains a .nolint file
  * @return
- *        Returns true if any valid objects were found
+ *        Returns false if the directory could not be opened
  */
-auto fsGetDirContents(const string& path, vector<string>& dirs) -> bool {
-  dirs.clear();
+auto fsScanDir(const string& path, vector<DirEntry>& entries, bool& noLint) -> bool {
+  entries.clear();
+  noLint = false;
 
 #ifdef _WIN32
   // windows.h Implementation of directory traversal for Windows systems
   HANDLE          dir;
   WIN32_FIND_DATA fileData;
 
+  ++Stats.dirOpens;
   if ((dir = FindFirstFile((path + FS_SEP + "*").c_str(), &fileData)) == INVALID_HANDLE_VALUE) {
     return false; /* No files found */
   }
 
   do {
-    const string fsObj = fileData.cFileName;
+    string fsObj = fileData.cFileName;
 
     if (fs_isnot_specialdir(fsObj) && fs_isnot_git(fsObj)) {
-      const string fileName = path + FS_SEP + fsObj;
-      dirs.push_back(move(fileName));
+      const FSType type = (fileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ? FSType::IS_DIR : FSType::IS_FILE;
+      if (type == FSType::IS_FILE && fsObj == ".nolint") noLint = true;
+      entries.push_back({move(fsObj), type});
     }
   } while (FindNextFile(dir, &fileData));
 
   FindClose(dir);
 #else
   // dirent.h Implementation of directory traversal for POSIX systems
-  if (DIR* pDIR = opendir(path.c_str())) {
-    while (struct dirent* entry = readdir(pDIR)) {
-      const string fsObj{entry->d_name};
-      if (fs_isnot_specialdir(fsObj) && fs_isnot_git(fsObj)) dirs.emplace_back(path + FS_SEP + fsObj);
+  ++Stats.dirOpens;
+  DIR* pDIR = opendir(path.c_str());
+  if (!pDIR) return false;
+
+  const int fd = dirfd(pDIR);
+  while (struct dirent* entry = readdir(pDIR)) {
+    string fsObj{entry->d_name};
+    if (!fs_isnot_specialdir(fsObj) || !fs_isnot_git(fsObj)) continue;
+
+    FSType type;
+    switch (entry->d_type) {
+      case DT_DIR:
+        type = FSType::IS_DIR;
+        break;
+      case DT_REG:
+        type = FSType::IS_FILE;
+        break;
+      default: {
+        // Symlinks, special files, and file systems that do not fill in d_type
+        struct stat info;
+        ++Stats.statCalls;
+        type = fstatat(fd, entry->d_name, &info, 0) ? FSType::NO_ACCESS : fsTypeOfMode(info.st_mode);
+      }
     }
-    closedir(pDIR);
+
+    if (type == FSType::IS_FILE && fsObj == ".nolint") noLint = true;
+    entries.push_back({move(fsObj), type});
   }
+  closedir(pDIR);
 
-  stable_sort(dirs.begin(), dirs.end());
+  stable_sort(entries.begin(), entries.end(), [](const DirEntry& a, const DirEntry& b) { return a.name < b.name; });
 #endif
-  return !dirs.empty();
+  return true;
+};
+
+namespace {
+// Files at least this big are mapped rather than read; below it, mmap()'s
+// setup and page faults cost more than copying from the page cache
+constexpr size_t kMapThreshold = 64 * 1024;
+
+// Read buffers are recycled from file to file. Each thread keeps a few for
+// itself and hands any extra to a shared pool, so that a thread which only
+// reads (see --pipeline) picks up the buffers released by the lint threads.
+constexpr size_t kLocalBuffers = 4, kSharedBuffers = 64;
+
+struct PooledBuffer {
+  unique_ptr<char[]> data;
+  size_t             capacity{0};
+};
+
+thread_local vector<PooledBuffer> t_buffers;
+mutex                             sharedBuffersMutex;
+vector<PooledBuffer>              sharedBuffers;
+
+auto acquireBuffer() -> PooledBuffer {
+  PooledBuffer buffer;
+  if (!t_buffers.empty()) {
+    buffer = move(t_buffers.back());
+    t_buffers.pop_back();
+    return buffer;
+  }
+
+  lock_guard<mutex> lock(sharedBuffersMutex);
+  if (!sharedBuffers.empty()) {
+    buffer = move(sharedBuffers.back());
+    sharedBuffers.pop_back();
+  }
+  return buffer;
+};
+
+void releaseBuffer(PooledBuffer buffer) {
+  if (t_buffers.size() < kLocalBuffers) {
+    t_buffers.push_back(move(buffer));
+    return;
+  }
+
+  lock_guard<mutex> lock(sharedBuffersMutex);
+  if (sharedBuffers.size() < kSharedBuffers) sharedBuffers.push_back(move(buffer));
 };
 
 /**
- * Attempts to load a file into a std::string
+ * Makes sure a buffer can hold at least the given number of bytes,
+ * keeping the first used bytes of its contents
+ */
+void reserveBuffer(PooledBuffer& buffer, size_t used, size_t needed) {
+  if (buffer.capacity >= needed) return;
+
+  const size_t       capacity = max(needed, 2 * buffer.capacity);
+  unique_ptr<char[]> data{new char[capacity]};
+  if (used > 0) memcpy(data.get(), buffer.data.get(), used);
+  buffer.data     = move(data);
+  buffer.capacity = capacity;
+};
+};  // namespace
+
+// The contents of a FileBuffer that holds nothing: an empty, '\0' terminated string
+static const char kNoContents[] = "";
+
+FileBuffer::FileBuffer() NOEXCEPT: m_data(kNoContents){};
+
+FileBuffer::~FileBuffer() {
+  release();
+};
+
+FileBuffer::FileBuffer(FileBuffer&& other) NOEXCEPT: m_data(kNoContents) {
+  *this = move(other);
+};
+
+auto FileBuffer::operator=(FileBuffer&& other) NOEXCEPT -> FileBuffer& {
+  if (this != &other) {
+    release();
+    m_data         = other.m_data;
+    m_size         = other.m_size;
+    m_mapped       = other.m_mapped;
+    m_buffer       = move(other.m_buffer);
+    m_capacity     = other.m_capacity;
+    other.m_data   = kNoContents;
+    other.m_size   = 0;
+    other.m_mapped = false;
+  }
+  return *this;
+};
+
+void FileBuffer::release() {
+#ifndef _WIN32
+  if (m_mapped) munmap(const_cast<char*>(m_data), m_size);
+#endif
+  if (m_buffer) {
+    PooledBuffer buffer;
+    buffer.data     = move(m_buffer);
+    buffer.capacity = m_capacity;
+    releaseBuffer(move(buffer));
+  }
+
+  m_data     = kNoContents;
+  m_capacity = 0;
+  m_size   = 0;
+  m_mapped = false;
+};
+
+/**
+ * Attempts to load a file, replacing anything held before
+ *
+ * Regular files big enough to be worth it are memory mapped, as long as
+ * their size is not a multiple of the page size: the rest of the last page
+ * then reads as zeroes, which provides the terminating '\0' for free.
+ * Everything else (small files, pipes, ...) is read into a recycled buffer.
  *
  * @param path
  *        The file to load
- * @param file
- *        The string to load into
  * @return
  *        Returns a bool of whether the load was successful
  */
-auto getFileContents(const string& path, string& file) -> bool {
-  ifstream in(path);
-  if (in) {
-    stringstream buffer;
-    buffer << in.rdbuf();
-    file = buffer.str();
+auto FileBuffer::load(const string& path) -> bool {
+  release();
+  ++Stats.fileOpens;
+
+  PooledBuffer buffer = acquireBuffer();
+  size_t       used   = 0;
+
+#ifdef _WIN32
+  // Text mode, so line endings are translated like they always were
+  FILE* file = fopen(path.c_str(), "r");
+  if (!file) {
+    releaseBuffer(move(buffer));
+    return false;
+  }
+
+  while (true) {
+    reserveBuffer(buffer, used, used + 64 * 1024 + 1);
+    const size_t got = fread(buffer.data.get() + used, 1, buffer.capacity - used - 1, file);
+    used += got;
+    if (got == 0) break;
+  }
+  const bool ok = !ferror(file);
+  fclose(file);
+#else
+  const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    releaseBuffer(move(buffer));
+    return false;
+  }
+
+  struct stat info;
+  ++Stats.statCalls;
+  const bool   isFile   = fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+  const size_t fileSize = isFile ? static_cast<size_t>(info.st_size) : 0;
+
+  static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  if (fileSize >= kMapThreshold && fileSize % pageSize != 0) {
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    // The whole file is about to be read, so fault it all in at once
+    flags |= MAP_POPULATE;
+#endif
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, flags, fd, 0);
+    if (mapping != MAP_FAILED) {
+      close(fd);
+      releaseBuffer(move(buffer));
+      ++Stats.filesMapped;
+
+      m_data   = static_cast<const char*>(mapping);
+      m_size   = fileSize;
+      m_mapped = true;
+      return true;
+    }
+  }
+
+  // Read until EOF; for regular files the size is known up front
+  bool ok = true;
+  while (true) {
+    reserveBuffer(buffer, used, max(used + 64 * 1024, fileSize) + 1);
+    const ssize_t got = read(fd, buffer.data.get() + used, buffer.capacity - used - 1);
+    if (got < 0) {
+      if (errno == EINTR) continue;
+      ok = false;
+      break;
+    }
+    if (got == 0) break;
+    used += static_cast<size_t>(got);
+    if (isFile && used == fileSize) break;
+  }
+  close(fd);
+#endif
+
+  if (!ok) {
+    releaseBuffer(move(buffer));
+    return false;
+  }
+
+  buffer.data[used] = '\0';
+  m_data            = buffer.data.get();
+  m_size            = used;
+  m_buffer          = move(buffer.data);
+  m_capacity        = buffer.capacity;
+  return true;
+};
+
+/**
+ * Creates a directory, unless it already exists
+ *
+ * @param path
+ *        The directory to create
+ * @return
+ *        Returns true if the directory exists afterwards
+ */
+auto fsMakeDir(const string& path) -> bool {
+#ifdef _WIN32
+  CreateDirectory(path.c_str(), nullptr);
+#else
+  mkdir(path.c_str(), 0777);
+#endif
+  // Somebody else may have created it first, which is just as good
+  return fsObjectExists(path) == FSType::IS_DIR;
+};
 
-    return true;
+/**
+ * Atomically moves a file over another one, so that anyone opening the
+ * destination sees either the old or the new file, never a partial one
+ *
+ * @param from
+ *        The file to move
+ * @param to
+ *        Where to move it, replacing any file already there
+ * @return
+ *        Returns a bool of whether the move was successful
+ */
+auto fsReplaceFile(const string& from, const string& to) -> bool {
+#ifdef _WIN32
+  return MoveFileEx(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return rename(from.c_str(), to.c_str()) == 0;
+#endif
+};
+
+/**
+ * Fetches the current working directory
+ *
+ * @return
+ *        Returns the directory, or an empty string if it is unknown
+ */
+auto fsCurrentDir() -> string {
+  char path[4096];
+#ifdef _WIN32
+  if (!_getcwd(path, sizeof(path))) return string();
+#else
+  if (!getcwd(path, sizeof(path))) return string();
+#endif
+  return path;
+};
+
+auto fsIsAbsolute(const string& path) -> bool {
+#ifdef _WIN32
+  return path.size() > 1 && (path[1] == ':' || path[0] == '\\' || path[0] == '/');
+#else
+  return !path.empty() && path[0] == '/';
+#endif
+};
+
+/**
+ * Spells a path the shortest way without looking at the file system,
+ * dropping "." and empty components and folding ".." into its parent
+ *
+ * @param path
+ *        The path to normalize
+ * @return
+ *        Returns the normalized path
+ */
+auto normalizePath(const string& path) -> string {
+  const auto isSep = [](char c) {
+#ifdef _WIN32
+    return c == '/' || c == '\\';
+#else
+    return c == '/';
+#endif
+  };
+
+  // The root (and on Windows, the drive) is kept as it is
+  size_t rootSize = 0;
+#ifdef _WIN32
+  if (path.size() > 1 && path[1] == ':') rootSize = 2;
+#endif
+  while (rootSize < path.size() && isSep(path[rootSize])) ++rootSize;
+  const bool rooted = rootSize > 0 && isSep(path[rootSize - 1]);
+
+  vector<string> parts;
+  for (size_t pos = rootSize, end; pos < path.size(); pos = end + 1) {
+    end = pos;
+    while (end < path.size() && !isSep(path[end])) ++end;
+    const string part = path.substr(pos, end - pos);
+
+    if (part.empty() || part == ".") continue;
+    if (part == ".." && !parts.empty() && parts.back() != "..")
+      parts.pop_back();
+    else if (part != ".." || !rooted)  // Nothing is above the root
+      parts.push_back(part);
+  }
+
+  string result = path.substr(0, rootSize);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    if (i > 0) result += FS_SEP;
+    result += parts[i];
+  }
+  return result.empty() ? "." : result;
+};
+
+/**
+ * Counts the CPUs this process may run on
+ *
+ * @return
+ *        Returns the number of usable CPUs (always at least one)
+ */
+auto getUsableCPUs() -> size_t {
+#ifdef __linux__
+  // Respects taskset/cgroup cpusets, unlike hardware_concurrency()
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0 && CPU_COUNT(&set) > 0) return CPU_COUNT(&set);
+#endif
+  return max(thread::hardware_concurrency(), 1u);
+};
+
+namespace {
+// The XXH64 primes
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+inline auto rotl64(uint64_t x, int r) -> uint64_t {
+  return (x << r) | (x >> (64 - r));
+};
+
+inline auto read64(const char* p) -> uint64_t {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+};
+
+inline auto read32(const char* p) -> uint32_t {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+};
+
+inline auto hashRound(uint64_t acc, uint64_t input) -> uint64_t {
+  return rotl64(acc + input * kPrime2, 31) * kPrime1;
+};
+
+inline auto hashMerge(uint64_t acc, uint64_t val) -> uint64_t {
+  return (acc ^ hashRound(0, val)) * kPrime1 + kPrime4;
+};
+};  // namespace
+
+/**
+ * Hashes a block of memory with XXH64, which is fast enough that hashing a
+ * file costs a small fraction of reading it
+ *
+ * @param data
+ *        The start of the memory to hash
+ * @param size
+ *        The number of bytes to hash
+ * @param seed
+ *        Starting value, to derive independent hashes
+ * @return
+ *        Returns the 64 bit hash (for little endian hosts, the standard XXH64 value)
+ */
+auto hashBytes(const char* data, size_t size, uint64_t seed) -> uint64_t {
+  const char* const end = data + size;
+  uint64_t          h;
+
+  if (size >= 32) {
+    uint64_t v1 = seed + kPrime1 + kPrime2, v2 = seed + kPrime2, v3 = seed, v4 = seed - kPrime1;
+    for (; end - data >= 32; data += 32) {
+      v1 = hashRound(v1, read64(data));
+      v2 = hashRound(v2, read64(data + 8));
+      v3 = hashRound(v3, read64(data + 16));
+      v4 = hashRound(v4, read64(data + 24));
+    }
+    h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+    h = hashMerge(h, v1);
+    h = hashMerge(h, v2);
+    h = hashMerge(h, v3);
+    h = hashMerge(h, v4);
+  } else {
+    h = seed + kPrime5;
   }
-  return false;
+  h += size;
+
+  for (; end - data >= 8; data += 8) h = rotl64(h ^ hashRound(0, read64(data)), 27) * kPrime1 + kPrime4;
+  if (end - data >= 4) {
+    h = rotl64(h ^ (read32(data) * kPrime1), 23) * kPrime2 + kPrime3;
+    data += 4;
+  }
+  for (; data != end; ++data) h = rotl64(h ^ (static_cast<uint8_t>(*data) * kPrime5), 11) * kPrime1;
+
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= kPrime3;
+  h ^= h >> 32;
+  return h;
 };
 
 #if 0
@@ -159,7 +608,7 @@ bool startsWith(const T& str, const T& prefix) {
  * @return
  *        Returns true if str starts with an instance of prefix
  */
-auto startsWith(string::const_iterator str_iter, const char* prefix) -> bool {
+auto startsWith(const char* str_iter, const char* prefix) -> bool {
   while (*prefix != '\0' && *prefix == *str_iter) {
     ++prefix;
     ++str_iter;
@@ -5,6 +5,8 @@
  * that were hidden away in boost or facebook's folly library
  */
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -23,17 +25,67 @@ enum FSType { NO_ACCESS, IS_FILE, IS_DIR };
 
 auto fsObjectExists(const std::string& path) -> FSType;
 
-auto fsContainsNoLint(const std::string& path) -> bool;
+// A directory entry, named relative to its directory
+struct DirEntry {
+  std::string name;
+  FSType      type;
+};
 
-auto fsGetDirContents(const std::string& path, std::vector<std::string>& dir) -> bool;
+auto fsScanDir(const std::string& path, std::vector<DirEntry>& entries, bool& noLint) -> bool;
 
-auto getFileContents(const std::string& path, std::string& file) -> bool;
+auto fsFileSize(const std::string& path) -> uint64_t;
+
+/*
+ * The contents of a file, loaded without copying where possible
+ *
+ * The contents are always followed by a '\0' (*end() == '\0'), so they can
+ * be handed straight to the tokenizer. They stay valid until the buffer is
+ * released, reloaded or destroyed.
+ */
+class FileBuffer {
+ public:
+  FileBuffer() NOEXCEPT;
+  ~FileBuffer();
+
+  FileBuffer(FileBuffer&& other) NOEXCEPT;
+  auto operator=(FileBuffer&& other) NOEXCEPT -> FileBuffer&;
+  FileBuffer(const FileBuffer&) = delete;
+  auto operator=(const FileBuffer&) -> FileBuffer& = delete;
+
+  auto load(const std::string& path) -> bool;
+  void release();
+
+  auto begin() const -> const char* { return m_data; };
+  auto end() const -> const char* { return m_data + m_size; };
+  auto size() const -> size_t { return m_size; };
+
+ private:
+  const char*             m_data;
+  size_t                  m_size{0};
+  bool                    m_mapped{false};
+  std::unique_ptr<char[]> m_buffer;  // backs m_data unless it is mapped
+  size_t                  m_capacity{0};
+};
+
+auto fsMakeDir(const std::string& path) -> bool;
+
+auto fsReplaceFile(const std::string& from, const std::string& to) -> bool;
+
+auto fsCurrentDir() -> std::string;
+
+auto fsIsAbsolute(const std::string& path) -> bool;
+
+auto normalizePath(const std::string& path) -> std::string;
+
+auto getUsableCPUs() -> size_t;
+
+auto hashBytes(const char* data, size_t size, uint64_t seed = 0) -> uint64_t;
 
 #if 0
 bool startsWith(const std::string &str, const std::string &prefix);
 #endif
 
-auto startsWith(std::string::const_iterator str_iter, const char* prefix) -> bool;
+auto startsWith(const char* str_iter, const char* prefix) -> bool;
 
 auto escapeString(const std::string& input) -> std::string;
 };  // namespace flint
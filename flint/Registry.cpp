@@ -0,0 +1,142 @@
+#include "Registry.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "Options.hpp"
+
+using namespace std;
+
+namespace flint {
+
+CheckPlan Plan;
+
+auto registeredChecks() -> const vector<RegisteredCheck>& {
+  static const vector<RegisteredCheck> checks = [] {
+    vector<RegisteredCheck> all;
+#define X(func)        all.push_back({#func, traits##func, make##func##Check, nullptr})
+#define X_struct(func) all.push_back({#func, traits##func, nullptr, check##func})
+#include "Checks.inc"
+#undef X_struct
+#undef X
+
+    sort(all.begin(), all.end(), [](const RegisteredCheck& a, const RegisteredCheck& b) {
+      return a.traits.level != b.traits.level ? a.traits.level < b.traits.level : a.name < b.name;
+    });
+    return all;
+  }();
+  return checks;
+};
+
+namespace {
+/**
+ * Marks the checks named in a list
+ *
+ * @param list
+ *        Check names separated by commas
+ * @param option
+ *        The option the list was given to, for the error message
+ * @param value
+ *        What to set the named checks to in selected
+ * @param selected
+ *        One flag per registered check
+ * @return
+ *        Returns false, after printing why, if a name is not a check
+ */
+auto select(const string& list, const char* option, bool value, vector<bool>& selected) -> bool {
+  const vector<RegisteredCheck>& checks = registeredChecks();
+
+  size_t begin = 0;
+  while (begin <= list.size()) {
+    size_t end = list.find(',', begin);
+    if (end == string::npos) end = list.size();
+
+    const string name = list.substr(begin, end - begin);
+    begin             = end + 1;
+    if (name.empty()) continue;
+
+    const auto found =
+        find_if(checks.begin(), checks.end(), [&name](const RegisteredCheck& check) { return check.name == name; });
+    if (found == checks.end()) {
+      fprintf(stderr, "Unknown check '%s' given to %s; see --list-checks.\n\n", name.c_str(), option);
+      return false;
+    }
+    selected[found - checks.begin()] = value;
+  }
+  return true;
+};
+
+const char* const categoryNames[NUM_FILE_CATEGORIES] = {"headers", "-inl headers", "C sources", "C++ sources", "others"};
+};  // namespace
+
+auto CheckPlan::build() -> bool {
+  const vector<RegisteredCheck>& checks = registeredChecks();
+
+  vector<bool> selected(checks.size(), Options.ENABLE.empty());
+  if (!select(Options.ENABLE, "--enable", true, selected) || !select(Options.DISABLE, "--disable", false, selected))
+    return false;
+
+  for (auto& steps: m_steps) steps.clear();
+  for (size_t i = 0; i < checks.size(); ++i) {
+    const CheckTraits& traits = checks[i].traits;
+    if (!selected[i] || traits.level > Options.LEVEL || (traits.cppOnly && Options.CMODE)) continue;
+
+    for (unsigned category = 0; category < NUM_FILE_CATEGORIES; ++category) {
+      if ((traits.categories & categoryBit(static_cast<FileCategory>(category))) != 0)
+        m_steps[category].push_back(&checks[i]);
+    }
+  }
+  return true;
+};
+
+auto CheckPlan::runs(const RegisteredCheck& check) const -> bool {
+  for (const auto& steps: m_steps)
+    if (find(steps.begin(), steps.end(), &check) != steps.end()) return true;
+  return false;
+};
+
+void CheckPlan::addTo(FileCategory category, Dispatcher& checks) const {
+  for (const RegisteredCheck* step: m_steps[category]) {
+    if (step->make)
+      checks.add(step->make());
+    else
+      checks.add(step->check);
+  }
+};
+
+auto CheckPlan::describe() const -> string {
+  string description;
+  for (unsigned category = 0; category < NUM_FILE_CATEGORIES; ++category) {
+    description += categoryNames[category];
+    for (const RegisteredCheck* step: m_steps[category]) description += ' ' + step->name;
+    description += '\n';
+  }
+  return description;
+};
+
+void printChecks() {
+  static const char* const levelNames[] = {"error", "warning", "advice"};
+
+  for (const RegisteredCheck& check: registeredChecks()) {
+    const CheckTraits& traits = check.traits;
+
+    // Files of unknown categories are never linted, so they are left out
+    string files;
+    if ((traits.categories | categoryBit(UNKNOWN)) == ALL_FILE_CATEGORIES) {
+      files = "all files";
+    } else {
+      for (unsigned category = 0; category < UNKNOWN; ++category) {
+        if ((traits.categories & categoryBit(static_cast<FileCategory>(category))) == 0) continue;
+        files += (files.empty() ? "" : ", ") + string(categoryNames[category]);
+      }
+    }
+
+    printf("%-26s %-8s %-6s %-4s %s\n",
+           check.name.c_str(),
+           levelNames[traits.level],
+           traits.cppOnly ? "C++" : "C/C++",
+           Plan.runs(check) ? "on" : "off",
+           files.c_str());
+  }
+};
+};  // namespace flint
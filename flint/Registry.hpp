@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Checks.hpp"
+#include "Dispatcher.hpp"
+#include "FileCategories.hpp"
+
+namespace flint {
+
+/*
+ * A check as listed in Checks.inc; exactly one of make and check is set
+ */
+struct RegisteredCheck {
+  using MakeCheck = std::unique_ptr<TokenCheck> (*)();
+
+  std::string             name;
+  CheckTraits             traits;
+  MakeCheck               make;
+  Dispatcher::StructCheck check;
+};
+
+/**
+ * @return
+ *        Returns every check, in the order their reports appear for a file:
+ *        those reporting errors first, then by name
+ */
+auto registeredChecks() -> const std::vector<RegisteredCheck>&;
+
+/*
+ * The checks to run on each category of file
+ *
+ * Decided once at startup from --level, --cmode, --enable and --disable,
+ * so a check which doesn't apply to a file is never called on it, rather
+ * than each check testing the options and the path for itself.
+ */
+class CheckPlan {
+ public:
+  /**
+   * Picks the checks to run from the options
+   *
+   * @return
+   *        Returns false, after printing why, if --enable or --disable name
+   *        a check that doesn't exist
+   */
+  auto build() -> bool;
+
+  /**
+   * @return
+   *        Returns whether the check runs on any category of file
+   */
+  auto runs(const RegisteredCheck& check) const -> bool;
+
+  /**
+   * Adds the checks of a file category to a dispatcher, which each worker
+   * thread keeps for files of that category
+   */
+  void addTo(FileCategory category, Dispatcher& checks) const;
+
+  /**
+   * @return
+   *        Returns the checks of every category by name, one category per
+   *        line; it changes whenever the checks run on some file do
+   */
+  auto describe() const -> std::string;
+
+ private:
+  std::vector<const RegisteredCheck*> m_steps[NUM_FILE_CATEGORIES];
+};
+extern CheckPlan Plan;
+
+/**
+ * Prints every check, what it applies to and whether it is planned to
+ * run, for --list-checks
+ */
+void printChecks();
+};  // namespace flint
@@ -0,0 +1,229 @@
+#include "Scopes.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace flint {
+
+void ScopeTree::build(const TokenList& tokens) {
+  const auto size = static_cast<uint32_t>(tokens.size());
+  m_scopes.clear();
+  m_access.clear();
+  m_open.clear();
+
+  m_scopes.push_back(
+      {ScopeKind::FILE, 0, 0, 0, Scope::NO_TOKEN, Scope::NO_TOKEN, 0, size == 0 ? 0 : size - 1});
+  m_open.push_back(0);
+
+  // The class or namespace whose head was seen last, until its '{'
+  Scope    pending{};
+  uint32_t pendingOpen = Scope::NO_TOKEN;
+  size_t   functions   = 0;  // How many of the open scopes are functions
+
+  const uint8_t* types = tokens.types();
+  for (uint32_t pos = 0; pos < size; ++pos) {
+    switch (types[pos]) {
+      case TK_CLASS:
+      case TK_STRUCT:
+      case TK_UNION:
+        // Not a class-key inside the head of another class, nor an enum class
+        if (pendingOpen != Scope::NO_TOKEN || (pos > 0 && types[pos - 1] == TK_ENUM)) break;
+        pendingOpen = classBody(tokens, pos, pending);
+        break;
+      case TK_NAMESPACE:
+        if (pendingOpen != Scope::NO_TOKEN || (pos > 0 && types[pos - 1] == TK_USING)) break;
+        pendingOpen = namespaceBody(tokens, pos, pending);
+        break;
+      case TK_PUBLIC:
+      case TK_PROTECTED:
+      case TK_PRIVATE: {
+        // Only labels count, as in "public:" or Qt's "public slots:"
+        const bool label = pos + 2 < size && (types[pos + 1] == TK_COLON ||
+                                              (types[pos + 1] == TK_IDENTIFIER && types[pos + 2] == TK_COLON));
+        if (label && m_scopes[m_open.back()].isClass())
+          m_access.push_back({pos, m_open.back(), static_cast<TokenType>(types[pos])});
+      } break;
+      case TK_LCURL: {
+        Scope scope{};
+        if (pos == pendingOpen) {
+          scope       = pending;
+          pendingOpen = Scope::NO_TOKEN;
+        } else {
+          scope.kind_  = (functions == 0 && isFunctionBody(tokens, pos)) ? ScopeKind::FUNCTION : ScopeKind::BLOCK;
+          scope.head_  = pos;
+          scope.name_  = Scope::NO_TOKEN;
+          scope.bases_ = Scope::NO_TOKEN;
+        }
+        scope.parent_ = m_open.back();
+        scope.open_   = pos;
+        scope.close_  = static_cast<uint32_t>(tokens.partner(pos));
+        if (scope.kind_ == ScopeKind::FUNCTION) ++functions;
+
+        m_open.push_back(static_cast<uint32_t>(m_scopes.size()));
+        m_scopes.push_back(scope);
+      } break;
+      case TK_RCURL: {
+        // A stray '}' closes nothing
+        Scope& scope = m_scopes[m_open.back()];
+        if (m_open.size() == 1 || scope.close_ != pos) break;
+        if (scope.kind_ == ScopeKind::FUNCTION) --functions;
+        scope.end_ = static_cast<uint32_t>(m_scopes.size());
+        m_open.pop_back();
+      } break;
+      default: break;
+    }
+  }
+
+  // Scopes never closed run up to the EOF token, as does the file
+  for (const uint32_t open: m_open) m_scopes[open].end_ = static_cast<uint32_t>(m_scopes.size());
+};
+
+auto ScopeTree::accessAt(size_t scope, size_t pos) const -> TokenType {
+  const Scope& found = m_scopes[scope];
+  assert(found.isClass());
+
+  auto label =
+      upper_bound(m_access.begin(), m_access.end(), pos, [](size_t at, const Access& a) { return at < a.token; });
+  while (label != m_access.begin() && (--label)->token > found.open_) {
+    // Skip the labels of nested classes
+    if (label->scope == scope) return label->type;
+  }
+  return found.kind_ == ScopeKind::CLASS ? TK_PRIVATE : TK_PUBLIC;
+};
+
+auto ScopeTree::innermost(size_t pos) const -> size_t {
+  const auto found = upper_bound(
+      m_scopes.begin() + 1, m_scopes.end(), pos, [](size_t at, const Scope& scope) { return at < scope.open_; });
+
+  size_t index = static_cast<size_t>(found - m_scopes.begin()) - 1;
+  while (index != 0 && m_scopes[index].close_ < pos) index = m_scopes[index].parent_;
+  return index;
+};
+
+/**
+ * Reads the head of a class from its class-key up to the '{'
+ *
+ * @param pos
+ *        The position of the class-key
+ * @param scope
+ *        Filled with what the head tells of the class
+ * @return
+ *        Returns the position of the '{', or NO_TOKEN if the class-key
+ *        does not start a class definition (a declaration, a template
+ *        parameter, an elaborated type, ...)
+ */
+auto ScopeTree::classBody(const TokenList& tokens, size_t pos, Scope& scope) const -> size_t {
+  const TokenType key = tokens.type(pos);
+  scope.kind_  = key == TK_CLASS ? ScopeKind::CLASS : key == TK_STRUCT ? ScopeKind::STRUCT : ScopeKind::UNION;
+  scope.head_  = static_cast<uint32_t>(pos);
+  scope.name_  = Scope::NO_TOKEN;
+  scope.bases_ = Scope::NO_TOKEN;
+
+  size_t       names = 0;
+  const size_t size  = tokens.size();
+  for (++pos; pos < size; ++pos) {
+    switch (tokens.type(pos)) {
+      case TK_IDENTIFIER:
+        // The name comes last, but before 'final'
+        if (scope.name_ == Scope::NO_TOKEN || tokens.symbol(pos) != SYM_FINAL)
+          scope.name_ = static_cast<uint32_t>(pos);
+        ++names;
+        break;
+      case TK_LPAREN:
+        // A macro or attribute with arguments before the name, as in
+        // "struct alignas(8) Foo"; two names before it make a function
+        if (names != 1 || scope.name_ != pos - 1) return Scope::NO_TOKEN;
+        scope.name_ = Scope::NO_TOKEN;
+        pos         = tokens.partner(pos);
+        break;
+      case TK_LESS:
+      case TK_LSQUARE: pos = tokens.partner(pos); break;
+      case TK_DOUBLE_COLON: break;
+      case TK_COLON:
+        scope.bases_ = static_cast<uint32_t>(pos);
+        for (++pos; pos < size; ++pos) {
+          switch (tokens.type(pos)) {
+            case TK_LCURL: return pos;
+            case TK_LESS:
+            case TK_LPAREN: pos = tokens.partner(pos); break;
+            case TK_SEMICOLON:
+            case TK_RCURL: return Scope::NO_TOKEN;
+            default: break;
+          }
+        }
+        return Scope::NO_TOKEN;
+      case TK_LCURL: return pos;
+      default: return Scope::NO_TOKEN;
+    }
+  }
+  return Scope::NO_TOKEN;
+};
+
+/**
+ * Same as classBody(), from the 'namespace' keyword
+ */
+auto ScopeTree::namespaceBody(const TokenList& tokens, size_t pos, Scope& scope) const -> size_t {
+  scope.kind_  = ScopeKind::NAMESPACE;
+  scope.head_  = static_cast<uint32_t>(pos);
+  scope.name_  = Scope::NO_TOKEN;
+  scope.bases_ = Scope::NO_TOKEN;
+
+  const size_t size = tokens.size();
+  for (++pos; pos < size; ++pos) {
+    switch (tokens.type(pos)) {
+      case TK_IDENTIFIER:
+        // Past the name are only attributes, as in "namespace std _GLIBCXX_VISIBILITY(default)"
+        if (scope.name_ == Scope::NO_TOKEN || tokens.type(pos - 1) == TK_DOUBLE_COLON)
+          scope.name_ = static_cast<uint32_t>(pos);
+        break;
+      case TK_LPAREN:
+      case TK_LSQUARE: pos = tokens.partner(pos); break;
+      case TK_DOUBLE_COLON:
+      case TK_INLINE: break;
+      case TK_LCURL: return pos;
+      default: return Scope::NO_TOKEN;  // An alias, or not C++
+    }
+  }
+  return Scope::NO_TOKEN;
+};
+
+/**
+ * @param pos
+ *        The position of a '{' which is neither a class nor a namespace
+ * @return
+ *        Returns whether a parameter list comes before it, past any
+ *        qualifiers and trailing return type
+ */
+auto ScopeTree::isFunctionBody(const TokenList& tokens, size_t pos) const -> bool {
+  while (pos-- > 0) {
+    switch (tokens.type(pos)) {
+      case TK_RPAREN: return true;
+      case TK_GREATER: pos = tokens.partner(pos); break;
+      case TK_IDENTIFIER:
+      case TK_DOUBLE_COLON:
+      case TK_CONST:
+      case TK_VOLATILE:
+      case TK_AMPERSAND:
+      case TK_LOGICAL_AND:
+      case TK_STAR:
+      case TK_ARROW:
+      case TK_AUTO:
+      case TK_VOID:
+      case TK_BOOL:
+      case TK_CHAR:
+      case TK_WCHAR_T:
+      case TK_SHORT:
+      case TK_INT:
+      case TK_LONG:
+      case TK_SIGNED:
+      case TK_UNSIGNED:
+      case TK_FLOAT:
+      case TK_DOUBLE: break;
+      default: return false;
+    }
+  }
+  return false;
+};
+};  // namespace flint
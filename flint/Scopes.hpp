@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Tokenizer.hpp"
+
+namespace flint {
+
+enum class ScopeKind : uint8_t { FILE, NAMESPACE, CLASS, STRUCT, UNION, FUNCTION, BLOCK };
+
+/**
+ * One pair of curly brackets, or the whole file. Token positions are
+ * NO_TOKEN where there is nothing to point at.
+ */
+struct Scope {
+  static constexpr uint32_t NO_TOKEN = UINT32_MAX;
+
+  ScopeKind kind_;
+  uint32_t  parent_;  // The enclosing scope; the file is its own parent
+  uint32_t  end_;     // One past the last scope nested inside this one
+  uint32_t  head_;    // The class-key or 'namespace' keyword, else open_
+  uint32_t  name_;    // The identifier naming a class or namespace
+  uint32_t  bases_;   // The ':' starting the base classes of a class
+  uint32_t  open_;    // The '{', or the first token for the file
+  uint32_t  close_;   // The matching '}', or the EOF token for the file
+
+  auto isClass() const -> bool {
+    return kind_ == ScopeKind::CLASS || kind_ == ScopeKind::STRUCT || kind_ == ScopeKind::UNION;
+  };
+};
+
+/*
+ * The namespaces, classes, function bodies and other blocks of a file
+ *
+ * Built in one pass over the tokens after tokenize(), so the checks which
+ * need to know what encloses a token don't each skip around the file to
+ * work it out again. Scopes are kept in the order they open: those nested
+ * inside scopes()[i] are scopes()[i + 1] to scopes()[i].end_ - 1, and
+ * scopes()[0] is the file.
+ *
+ * Telling function bodies from other blocks is a guess from the tokens
+ * before the '{': a ')', maybe followed by qualifiers or a trailing return
+ * type, makes a function when outside of any function.
+ */
+class ScopeTree {
+ public:
+  /**
+   * Fills the tree from the tokens of a file, reusing its memory
+   */
+  void build(const TokenList& tokens);
+
+  auto scopes() const -> const std::vector<Scope>& { return m_scopes; };
+  auto operator[](size_t index) const -> const Scope& { return m_scopes[index]; };
+  auto size() const -> size_t { return m_scopes.size(); };
+
+  /**
+   * @param scope
+   *        The index of a class, struct or union
+   * @param pos
+   *        A token inside it
+   * @return
+   *        Returns TK_PUBLIC, TK_PROTECTED or TK_PRIVATE, whichever
+   *        applies at pos
+   */
+  auto accessAt(size_t scope, size_t pos) const -> TokenType;
+
+  /**
+   * @return
+   *        Returns the index of the innermost scope holding the token at
+   *        pos; the brackets of a scope belong to it
+   */
+  auto innermost(size_t pos) const -> size_t;
+
+ private:
+  auto classBody(const TokenList& tokens, size_t pos, Scope& scope) const -> size_t;
+  auto namespaceBody(const TokenList& tokens, size_t pos, Scope& scope) const -> size_t;
+  auto isFunctionBody(const TokenList& tokens, size_t pos) const -> bool;
+
+  // An access specifier directly inside a class
+  struct Access {
+    uint32_t  token;
+    uint32_t  scope;
+    TokenType type;
+  };
+
+  std::vector<Scope>    m_scopes;
+  std::vector<Access>   m_access;  // In the order of their tokens
+  std::vector<uint32_t> m_open;    // Only used by build(), kept to reuse its memory
+};
+};  // namespace flint
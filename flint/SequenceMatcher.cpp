@@ -0,0 +1,93 @@
+#include "SequenceMatcher.hpp"
+
+#include <algorithm>
+#include <deque>
+
+using namespace std;
+
+namespace flint {
+
+SequenceMatcher::SequenceMatcher(const vector<Sequence>& sequences) {
+  // The trie of the sequences: edges[state * NUM_TOKENS + type] is its child, or 0 if there is none
+  vector<uint16_t>         edges(NUM_TOKENS, 0);
+  vector<vector<uint32_t>> ends(1);
+  for (size_t sequence = 0; sequence < sequences.size(); ++sequence) {
+    assert(!sequences[sequence].empty());
+
+    size_t state = 0;
+    for (const TokenType type: sequences[sequence]) {
+      uint16_t& edge = edges[state * NUM_TOKENS + type];
+      if (edge == 0) {
+        assert(ends.size() < UINT16_MAX);
+        edge = static_cast<uint16_t>(ends.size());
+        ends.emplace_back();
+        edges.resize(edges.size() + NUM_TOKENS, 0);
+      }
+      state = edges[state * NUM_TOKENS + type];
+    }
+    ends[state].push_back(static_cast<uint32_t>(sequence));
+    m_lengths.push_back(static_cast<uint32_t>(sequences[sequence].size()));
+  }
+
+  for (size_t type = 0; type < NUM_TOKENS; ++type) {
+    if (edges[type] == 0) continue;
+    m_isStart[type] = true;
+    m_starts.push_back(static_cast<TokenType>(type));
+  }
+
+  // Breadth first, every missing edge of a state is taken from its
+  // failure state (the longest proper suffix in the trie), which was
+  // completed before it; the failure state's matches are its own too
+  const size_t     states = ends.size();
+  vector<uint16_t> next   = edges;
+  vector<uint16_t> failure(states, 0);
+  deque<uint16_t>  pending;
+  for (size_t type = 0; type < NUM_TOKENS; ++type)
+    if (edges[type] != 0) pending.push_back(edges[type]);
+
+  while (!pending.empty()) {
+    const uint16_t state = pending.front();
+    pending.pop_front();
+    ends[state].insert(ends[state].end(), ends[failure[state]].begin(), ends[failure[state]].end());
+
+    for (size_t type = 0; type < NUM_TOKENS; ++type) {
+      const uint16_t child = edges[state * NUM_TOKENS + type];
+      if (child == 0) {
+        next[state * NUM_TOKENS + type] = next[failure[state] * NUM_TOKENS + type];
+        continue;
+      }
+      failure[child] = next[failure[state] * NUM_TOKENS + type];
+      pending.push_back(child);
+    }
+  }
+
+  // Renumber the states so that those ending a sequence come last, and
+  // scan() only has to compare a state to m_firstFinal to know there is
+  // nothing to report; the start state, which ends none, stays 0
+  vector<uint16_t> order;
+  for (size_t state = 0; state < states; ++state)
+    if (ends[state].empty()) order.push_back(static_cast<uint16_t>(state));
+  m_firstFinal = static_cast<uint32_t>(order.size());
+  for (size_t state = 0; state < states; ++state)
+    if (!ends[state].empty()) order.push_back(static_cast<uint16_t>(state));
+
+  vector<uint16_t> renumbered(states);
+  for (size_t state = 0; state < states; ++state) renumbered[order[state]] = static_cast<uint16_t>(state);
+
+  // Rows of 256 are indexed with a shift
+  m_next.assign(states * ROW, 0);
+  for (size_t state = 0; state < states; ++state)
+    for (size_t type = 0; type < NUM_TOKENS; ++type)
+      m_next[state * ROW + type] = renumbered[next[order[state] * NUM_TOKENS + type]];
+
+  // The longest match, which starts first, is reported first
+  m_firstMatch.reserve(states - m_firstFinal + 1);
+  for (size_t state = m_firstFinal; state < states; ++state) {
+    vector<uint32_t>& found = ends[order[state]];
+    stable_sort(found.begin(), found.end(), [this](uint32_t a, uint32_t b) { return m_lengths[a] > m_lengths[b]; });
+    m_firstMatch.push_back(static_cast<uint32_t>(m_matches.size()));
+    m_matches.insert(m_matches.end(), found.begin(), found.end());
+  }
+  m_firstMatch.push_back(static_cast<uint32_t>(m_matches.size()));
+};
+};  // namespace flint
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SmallVector.hpp"
+#include "Tokenizer.hpp"
+
+namespace flint {
+
+/*
+ * Finds every occurrence of a set of token type sequences in one pass
+ *
+ * The sequences are compiled into a single Aho-Corasick automaton: each
+ * token costs one table lookup whatever the number of sequences, rather
+ * than one atSequence() per sequence and position. Between matches, tokens
+ * which can't start a sequence are skipped without looking up the table,
+ * or not looked at at all when their types are rare in the file.
+ *
+ * A check builds its matcher once, as a function-local static, and scans
+ * the tokens with a callback taking the index of the sequence found and
+ * where it starts. Like TokenCheck::visit(), the callback returns the
+ * first position it still wants matches to start at, so a check can skip
+ * over a block or a declaration.
+ *
+ * Matches are reported in the order they end, the longest first when
+ * several end on the same token.
+ */
+class SequenceMatcher {
+ public:
+  using Sequence = std::vector<TokenType>;
+
+  /**
+   * @param sequences
+   *        The token type sequences to look for, none of them empty; the
+   *        callback of scan() is given their index in this list
+   */
+  explicit SequenceMatcher(const std::vector<Sequence>& sequences);
+
+  /**
+   * @return
+   *        Returns the number of tokens in a sequence
+   */
+  auto length(size_t sequence) const -> size_t { return m_lengths[sequence]; };
+
+  /**
+   * Reports the sequences found between begin and end
+   *
+   * @param tokens
+   *        The token list for the file
+   * @param begin
+   *        The position of the first token to look at
+   * @param end
+   *        One past the last token to look at; no match runs past it
+   * @param onMatch
+   *        Called as onMatch(sequence, pos) on each match starting at pos;
+   *        returns the first position later matches may start at, at least
+   *        pos + 1, or end to stop
+   */
+  template<class OnMatch>
+  void scan(const TokenList& tokens, size_t begin, size_t end, OnMatch&& onMatch) const;
+
+ private:
+  struct Cursor {
+    const uint32_t* at;
+    const uint32_t* end;
+  };
+
+  /**
+   * @return
+   *        Returns the first position from pos on holding a token which
+   *        starts a sequence, or end if there is none
+   */
+  auto nextStart(const TokenList& tokens, size_t pos, size_t end, SmallVector<Cursor, 8>& cursors) const -> size_t;
+
+  // m_next[state * ROW + type] is the state after reading a token of that type; 0 is the start
+  static constexpr size_t ROW = 256;
+  std::vector<uint16_t>   m_next;
+  // The states from m_firstFinal on end sequences: for s = state - m_firstFinal, those are
+  // m_matches[m_firstMatch[s]] to m_matches[m_firstMatch[s + 1] - 1]
+  uint32_t               m_firstFinal = 0;
+  std::vector<uint32_t>  m_firstMatch;
+  std::vector<uint32_t>  m_matches;
+  std::vector<uint32_t>  m_lengths;
+  std::vector<TokenType> m_starts;  // The types that can start a sequence
+  bool                   m_isStart[NUM_TOKENS] = {};
+};
+
+template<class OnMatch>
+void SequenceMatcher::scan(const TokenList& tokens, size_t begin, size_t end, OnMatch&& onMatch) const {
+  SmallVector<Cursor, 8> cursors;
+
+  // The rare types are found from their positions, as the Dispatcher does,
+  // unless gathering them over the whole file costs more than the range
+  size_t candidates = 0;
+  for (const TokenType type: m_starts) candidates += tokens.count(type);
+  if (candidates * 16 < end - begin) {
+    for (const TokenType type: m_starts) {
+      const std::vector<uint32_t>& found = tokens.positions(type);
+      const uint32_t*              last  = found.data() + found.size();
+      cursors.push_back({std::lower_bound(found.data(), last, begin), last});
+    }
+  }
+
+  const uint8_t* types = tokens.types();
+  size_t         from  = begin;  // Matches starting before it are dropped
+  uint32_t       state = 0;
+  for (size_t pos = begin; pos < end; ++pos) {
+    if (state == 0) {
+      pos = nextStart(tokens, pos, end, cursors);
+      if (pos == end) break;
+    }
+
+    state = m_next[state * ROW + types[pos]];
+    if (state < m_firstFinal) continue;
+
+    const uint32_t ending = state - m_firstFinal;
+    for (uint32_t match = m_firstMatch[ending]; match < m_firstMatch[ending + 1]; ++match) {
+      const uint32_t sequence = m_matches[match];
+      const size_t   start    = pos + 1 - m_lengths[sequence];
+      if (start < from) continue;
+
+      const size_t next = onMatch(static_cast<size_t>(sequence), start);
+      assert(next > start);
+      if (next > pos) {
+        // Every match in progress started before next
+        state = 0;
+        pos   = next - 1;
+        break;
+      }
+      from = next > from ? next : from;
+    }
+  }
+};
+
+inline auto SequenceMatcher::nextStart(const TokenList& tokens, size_t pos, size_t end, SmallVector<Cursor, 8>& cursors)
+    const -> size_t {
+  if (cursors.empty()) {
+    const uint8_t* types = tokens.types();
+    while (pos < end && !m_isStart[types[pos]]) ++pos;
+    return pos;
+  }
+
+  size_t found = end;
+  for (Cursor& cursor: cursors) {
+    while (cursor.at != cursor.end && *cursor.at < pos) ++cursor.at;
+    if (cursor.at != cursor.end && *cursor.at < found) found = *cursor.at;
+  }
+  return found;
+};
+};  // namespace flint
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace flint {
+
+/*
+ * A vector keeping its first N items inside itself
+ *
+ * The checks collect a handful of arguments or name parts at a time, so
+ * with a fitting N they never touch the heap; past N the items move to a
+ * heap buffer, which is kept until the vector is destroyed. Items are
+ * copied bytewise, hence the trivially copyable restriction.
+ */
+template<typename T, size_t N>
+class SmallVector {
+  static_assert(std::is_trivially_copyable<T>::value, "SmallVector moves its items with memcpy");
+  static_assert(N > 0, "SmallVector needs room for at least one item");
+
+ public:
+  using value_type     = T;
+  using iterator       = T*;
+  using const_iterator = const T*;
+
+  SmallVector() = default;
+
+  SmallVector(const SmallVector&) = delete;
+  auto operator=(const SmallVector&) -> SmallVector& = delete;
+
+  auto begin() -> iterator { return data(); };
+  auto end() -> iterator { return data() + m_size; };
+  auto begin() const -> const_iterator { return data(); };
+  auto end() const -> const_iterator { return data() + m_size; };
+
+  auto size() const -> size_t { return m_size; };
+  auto empty() const -> bool { return m_size == 0; };
+
+  auto operator[](size_t pos) -> T& {
+    assert(pos < m_size);
+    return data()[pos];
+  };
+  auto operator[](size_t pos) const -> const T& {
+    assert(pos < m_size);
+    return data()[pos];
+  };
+  auto back() const -> const T& { return (*this)[m_size - 1]; };
+
+  void clear() { m_size = 0; };
+
+  void push_back(const T& item) {
+    if (m_size == capacity()) grow();
+    new (data() + m_size) T(item);
+    ++m_size;
+  };
+
+  template<typename... Args>
+  void emplace_back(Args&&... args) {
+    if (m_size == capacity()) grow();
+    new (data() + m_size) T(std::forward<Args>(args)...);
+    ++m_size;
+  };
+
+ private:
+  using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+  auto data() -> T* { return reinterpret_cast<T*>(m_heap.empty() ? m_inline : m_heap.data()); };
+  auto data() const -> const T* { return reinterpret_cast<const T*>(m_heap.empty() ? m_inline : m_heap.data()); };
+  auto capacity() const -> size_t { return m_heap.empty() ? N : m_heap.size(); };
+
+  void grow() {
+    std::vector<Slot> bigger(2 * capacity());
+    std::memcpy(bigger.data(), data(), m_size * sizeof(T));
+    m_heap.swap(bigger);
+  };
+
+  Slot              m_inline[N];
+  std::vector<Slot> m_heap;  // Empty while the items fit in m_inline
+  size_t            m_size = 0;
+};
+};  // namespace flint
@@ -0,0 +1,145 @@
+#include "Stats.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+using namespace std;
+
+namespace {
+// Counted per thread so that allocating never contends on a shared counter
+thread_local size_t t_allocations = 0;
+
+auto allocate(size_t size) -> void* {
+  ++t_allocations;
+  return malloc(size ? size : 1);
+};
+};  // namespace
+
+// Replacing the global allocation functions is how the allocations get counted
+auto operator new(size_t size) -> void* {
+  void* p = allocate(size);
+  if (!p) throw bad_alloc();
+  return p;
+};
+auto operator new[](size_t size) -> void* {
+  return operator new(size);
+};
+auto operator new(size_t size, const nothrow_t&) noexcept -> void* {
+  return allocate(size);
+};
+auto operator new[](size_t size, const nothrow_t&) noexcept -> void* {
+  return allocate(size);
+};
+void operator delete(void* p) noexcept {
+  free(p);
+};
+void operator delete[](void* p) noexcept {
+  free(p);
+};
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+};
+void operator delete[](void* p, size_t) noexcept {
+  free(p);
+};
+
+namespace flint {
+
+StatsInfo Stats;
+
+auto threadAllocations() -> size_t {
+  return t_allocations;
+};
+
+auto addPrefilter(const string& label) -> size_t {
+  static mutex added;
+  lock_guard<mutex> lock(added);
+
+  const size_t count = Stats.prefilterCount;
+  for (size_t i = 0; i < count; ++i)
+    if (Stats.prefilters[i].label == label) return i;
+
+  // No more than a Dispatcher's 64 checks
+  assert(count < extent<decltype(Stats.prefilters)>::value);
+  Stats.prefilters[count].label = label;
+  Stats.prefilterCount          = count + 1;
+  return count;
+};
+
+/**
+ * Prints how full a pipeline queue ran and who waited on it
+ *
+ * @param name
+ *        What the queue connects
+ * @param queue
+ *        The queue's statistics
+ * @param producer
+ *        Name of the stage pushing into the queue
+ * @param consumer
+ *        Name of the stage popping from the queue
+ */
+static void printQueue(const char* name, const QueueStats& queue, const char* producer, const char* consumer) {
+  const double avgDepth = queue.pushes ? static_cast<double>(queue.depthSum) / static_cast<double>(queue.pushes) : 0;
+  fprintf(stderr, "    %-18s: depth avg %.1f, max %zu of %zu\n", name, avgDepth, queue.maxDepth, queue.capacity);
+  fprintf(stderr, "    %-18s  %s stalled %zux (%.3fs), %s starved %zux (%.3fs)\n", "", producer, queue.pushStalls,
+          queue.pushStallSecs, consumer, queue.popStalls, queue.popStallSecs);
+};
+
+/**
+ * Prints what the .flintignore files kept out of the walk to stderr.
+ * Ignored directories are never opened, so what they hold is not counted.
+ */
+void printIgnoredStats() {
+  fprintf(stderr, "Ignored by .flintignore: %zu directories, %zu files (%llu bytes)\n",
+          static_cast<size_t>(Stats.ignoredDirs), static_cast<size_t>(Stats.ignoredFiles),
+          static_cast<unsigned long long>(Stats.ignoredBytes));
+};
+
+/**
+ * Prints the run summary to stderr, keeping stdout
+ * free for the report itself
+ */
+void printStats() {
+  const size_t stats = Stats.statCalls, dirs = Stats.dirOpens, opens = Stats.fileOpens;
+  const size_t files = Stats.filesLinted;
+
+  fprintf(stderr, "\nRun statistics:\n");
+  fprintf(stderr, "  Directories scanned : %zu\n", static_cast<size_t>(Stats.dirsScanned));
+  fprintf(stderr, "  Files linted        : %zu (%zu memory mapped)\n", files, static_cast<size_t>(Stats.filesMapped));
+  fprintf(stderr, "  File system calls   : %zu (stat %zu, opendir %zu, open %zu)\n", stats + dirs + opens, stats, dirs,
+          opens);
+  if (files > 0)
+    fprintf(stderr, "  Calls per file      : %.2f\n", static_cast<double>(stats + dirs + opens) / static_cast<double>(files));
+  if (files > 0)
+    fprintf(stderr, "  Allocations per file: %.2f\n",
+            static_cast<double>(Stats.lintAllocations) / static_cast<double>(files));
+  if (Stats.prefilterCount > 0) fprintf(stderr, "  Skipped by trigger identifiers:\n");
+  for (size_t i = 0; i < Stats.prefilterCount; ++i) {
+    const PrefilterStats& prefilter = Stats.prefilters[i];
+    const size_t          checked = prefilter.files, skipped = prefilter.skipped;
+    fprintf(stderr, "    %-18s: %zu of %zu files (%.1f%%)\n", prefilter.label.c_str(), skipped, checked,
+            checked ? 100.0 * static_cast<double>(skipped) / static_cast<double>(checked) : 0.0);
+  }
+  if (Stats.ignoredDirs > 0 || Stats.ignoredFiles > 0)
+    fprintf(stderr, "  Ignored             : %zu directories, %zu files\n", static_cast<size_t>(Stats.ignoredDirs),
+            static_cast<size_t>(Stats.ignoredFiles));
+
+  if (!Stats.pipelined) return;
+  fprintf(stderr, "  Pipeline queues:\n");
+  printQueue("read -> lint", Stats.readQueue, "reader", "linters");
+  printQueue("lint -> report", Stats.doneQueue, "linters", "reporter");
+  fprintf(stderr, "    %-18s: reader waited %zux (%.3fs) for the report to catch up\n", "reorder window",
+          Stats.windowStalls, Stats.windowStallSecs);
+
+  // Linters starving on an empty read queue means the disk cannot keep up;
+  // a reader blocked on a full one means the checks cannot
+  const double starved = Stats.readQueue.popStallSecs / static_cast<double>(max<size_t>(Stats.lintThreads, 1));
+  const double blocked = Stats.readQueue.pushStallSecs + Stats.windowStallSecs;
+  fprintf(stderr, "  Bound by            : %s\n", starved > blocked ? "reading (I/O)" : "linting (CPU)");
+};
+};  // namespace flint
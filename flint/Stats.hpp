@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "BoundedQueue.hpp"
+
+namespace flint {
+
+/*
+ * How often a check was skipped because a file held none of its trigger
+ * identifiers, see TokenCheck
+ */
+struct PrefilterStats {
+  std::string         label;       // The trigger identifiers
+  std::atomic<size_t> files{0};    // files the check would have run on
+  std::atomic<size_t> skipped{0};  // of those, how many it was skipped on
+};
+
+/*
+ * Counters behind the run summary printed with --stats
+ *
+ * They are bumped from every worker thread, so each one is atomic.
+ */
+struct StatsInfo {
+  // File system calls made while finding and reading files
+  std::atomic<size_t> statCalls{0};    // stat(), fstat() and fstatat()
+  std::atomic<size_t> dirOpens{0};     // opendir()
+  std::atomic<size_t> fileOpens{0};    // files opened for linting
+  std::atomic<size_t> filesMapped{0};  // of those, how many were memory mapped
+
+  // Work done
+  std::atomic<size_t> dirsScanned{0};
+  std::atomic<size_t> filesLinted{0};
+  std::atomic<size_t> lintAllocations{0};  // heap allocations made while linting files
+
+  // One per check with trigger identifiers, see addPrefilter()
+  PrefilterStats      prefilters[64];
+  std::atomic<size_t> prefilterCount{0};
+
+  // Pruned from the walk by .flintignore files
+  std::atomic<size_t>   ignoredDirs{0};
+  std::atomic<size_t>   ignoredFiles{0};
+  std::atomic<uint64_t> ignoredBytes{0};  // only measured with --print-ignored-stats
+
+  // Filled in by the pipeline (--pipeline) once all of its stages are done
+  bool       pipelined{false};
+  size_t     lintThreads{0};
+  QueueStats readQueue, doneQueue;  // reader -> lint and lint -> reporter
+  size_t     windowStalls{0};       // reader waiting for the report to catch up
+  double     windowStallSecs{0};
+};
+extern StatsInfo Stats;
+
+/**
+ * @return
+ *        Returns how many heap allocations the calling thread has made
+ */
+auto threadAllocations() -> size_t;
+
+/**
+ * Finds or makes the counters of a check with trigger identifiers. Every
+ * thread keeps its own checks, and they all share the counters of the same
+ * label.
+ *
+ * @param label
+ *        The check's trigger identifiers
+ * @return
+ *        Returns the index of the counters in Stats.prefilters
+ */
+auto addPrefilter(const std::string& label) -> size_t;
+
+void printStats();
+void printIgnoredStats();
+};  // namespace flint
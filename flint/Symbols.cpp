@@ -0,0 +1,72 @@
+#include "Symbols.hpp"
+
+#include <cstring>
+
+using namespace std;
+
+namespace flint {
+
+SymbolTable Symbols;
+
+namespace {
+// FNV-1a
+auto hashName(const char* text, size_t size) -> uint32_t {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; ++i) hash = (hash ^ static_cast<unsigned char>(text[i])) * 16777619u;
+  return hash;
+};
+};  // namespace
+
+SymbolTable::SymbolTable() {
+  m_names.emplace_back();
+#define CPPLINT_SYMBOL(s, sym) intern(s);
+  CPPLINT_FORALL_SYMBOLS(CPPLINT_SYMBOL)
+#undef CPPLINT_SYMBOL
+};
+
+auto SymbolTable::intern(const string& name) -> Symbol {
+  if (name.empty()) return SYM_NONE;
+
+  const Symbol found = find(name.data(), name.size());
+  if (found != SYM_NONE) return found;
+
+  const auto symbol = static_cast<Symbol>(m_names.size());
+  m_names.push_back(name);
+  m_lengths[static_cast<unsigned char>(name[0]) & 63] |= uint64_t{1} << (name.size() < 63 ? name.size() : 63);
+
+  // Keep the table at most half full
+  if (m_slots.size() < 2 * m_names.size())
+    rehash();
+  else {
+    const size_t mask = m_slots.size() - 1;
+    size_t       slot = hashName(name.data(), name.size()) & mask;
+    while (m_slots[slot] != SYM_NONE) slot = (slot + 1) & mask;
+    m_slots[slot] = symbol;
+  }
+  return symbol;
+};
+
+auto SymbolTable::lookup(const char* text, size_t size) const -> Symbol {
+  if (m_slots.empty()) return SYM_NONE;
+
+  const size_t mask = m_slots.size() - 1;
+  for (size_t slot = hashName(text, size) & mask; m_slots[slot] != SYM_NONE; slot = (slot + 1) & mask) {
+    const string& name = m_names[m_slots[slot]];
+    if (name.size() == size && memcmp(name.data(), text, size) == 0) return m_slots[slot];
+  }
+  return SYM_NONE;
+};
+
+void SymbolTable::rehash() {
+  size_t slots = 64;
+  while (slots < 4 * m_names.size()) slots *= 2;
+
+  m_slots.assign(slots, SYM_NONE);
+  for (Symbol symbol = 1; symbol < m_names.size(); ++symbol) {
+    const string& name = m_names[symbol];
+    size_t        slot = hashName(name.data(), name.size()) & (slots - 1);
+    while (m_slots[slot] != SYM_NONE) slot = (slot + 1) & (slots - 1);
+    m_slots[slot] = symbol;
+  }
+};
+};  // namespace flint
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace flint {
+
+// clang-format off
+/**
+ * Identifiers the checks look for. They are interned first, so their ids
+ * are the constants SYM_XYZ below.
+ */
+#define CPPLINT_FORALL_SYMBOLS(apply)             \
+  apply("NULL", SYM_NULL)                         \
+  apply("boost", SYM_BOOST)                       \
+  apply("exception", SYM_EXCEPTION)               \
+  apply("final", SYM_FINAL)                       \
+  apply("initializer_list", SYM_INITIALIZER_LIST) \
+  apply("lock_guard", SYM_LOCK_GUARD)             \
+  apply("memset", SYM_MEMSET)                     \
+  apply("once", SYM_ONCE)                         \
+  apply("shared_ptr", SYM_SHARED_PTR)             \
+  apply("std", SYM_STD)                           \
+  apply("strtok", SYM_STRTOK)                     \
+  apply("unique_ptr", SYM_UNIQUE_PTR)             \
+  apply("what", SYM_WHAT)
+
+/**
+ * The id of an interned identifier; 0 for any identifier that was not
+ */
+using Symbol = uint32_t;
+
+enum KnownSymbol : Symbol {
+  SYM_NONE,
+#define CPPLINT_SYMBOL(s, sym) sym,
+  CPPLINT_FORALL_SYMBOLS(CPPLINT_SYMBOL)
+#undef CPPLINT_SYMBOL
+  NUM_KNOWN_SYMBOLS
+};
+// clang-format on
+
+/*
+ * The identifiers given an id for the whole run
+ *
+ * Names are only interned at startup, before any file is tokenized; from
+ * then on the table is read by every thread without locking, and a given
+ * identifier has the same id in every file. Checks compare those ids
+ * instead of the identifiers' text.
+ */
+class SymbolTable {
+ public:
+  SymbolTable();
+
+  /**
+   * Gives a name an id, unless it already has one. Not thread safe: only
+   * call it before linting starts.
+   *
+   * @return
+   *        Returns the id of the name
+   */
+  auto intern(const std::string& name) -> Symbol;
+
+  /**
+   * @param text
+   *        The first byte of a non-empty identifier
+   * @param size
+   *        Its length
+   * @return
+   *        Returns the id of the identifier, or SYM_NONE
+   */
+  auto find(const char* text, size_t size) const -> Symbol {
+    // Most identifiers are turned down on their first byte and length alone
+    if ((m_lengths[static_cast<unsigned char>(text[0]) & 63] >> (size < 63 ? size : 63) & 1) == 0) return SYM_NONE;
+    return lookup(text, size);
+  };
+
+  auto name(Symbol symbol) const -> const std::string& { return m_names[symbol]; };
+  auto size() const -> size_t { return m_names.size(); };
+
+ private:
+  auto lookup(const char* text, size_t size) const -> Symbol;
+  void rehash();
+
+  std::vector<std::string> m_names;  // By id; m_names[SYM_NONE] is empty
+  std::vector<Symbol>      m_slots;  // Open addressing over the ids, SYM_NONE when free
+  // Bit n of m_lengths[c & 63] is set if a name starting with byte c is n
+  // bytes long (63 standing for any longer one)
+  uint64_t m_lengths[64] = {};
+};
+extern SymbolTable Symbols;
+};  // namespace flint
@@ -0,0 +1,103 @@
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+namespace flint {
+
+namespace {
+// Which pool (and which of its deques) the current thread works for
+thread_local ThreadPool* t_pool  = nullptr;
+thread_local size_t      t_index = 0;
+};  // namespace
+
+ThreadPool::ThreadPool(size_t threads) {
+  for (size_t i = 0; i < threads; ++i) m_queues.emplace_back(new Queue);
+  for (size_t i = 0; i < threads; ++i) m_threads.emplace_back(&ThreadPool::run, this, i);
+};
+
+ThreadPool::~ThreadPool() {
+  wait();
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (auto& t: m_threads) t.join();
+};
+
+void ThreadPool::submit(Task task) {
+  // Without any workers the caller does the work itself
+  if (m_threads.empty()) {
+    task();
+    return;
+  }
+
+  const size_t target = (t_pool == this) ? t_index : (m_next++ % m_queues.size());
+  {
+    lock_guard<mutex> lock(m_mutex);
+    ++m_pending;
+  }
+  {
+    Queue&            queue = *m_queues[target];
+    lock_guard<mutex> lock(queue.mutex);
+    queue.tasks.push_back(move(task));
+    ++m_queued;
+  }
+  // Taking the lock orders this against a worker that is about to sleep
+  { lock_guard<mutex> lock(m_mutex); }
+  m_wake.notify_one();
+};
+
+void ThreadPool::wait() {
+  unique_lock<mutex> lock(m_mutex);
+  m_idle.wait(lock, [this] { return m_pending == 0; });
+};
+
+auto ThreadPool::take(size_t self, Task& task) -> bool {
+  // Newest task from our own deque first...
+  {
+    Queue&            own = *m_queues[self];
+    lock_guard<mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = move(own.tasks.back());
+      own.tasks.pop_back();
+      --m_queued;
+      return true;
+    }
+  }
+
+  // ...then the oldest task of somebody else
+  for (size_t i = 1, size = m_queues.size(); i < size; ++i) {
+    Queue&            victim = *m_queues[(self + i) % size];
+    lock_guard<mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = move(victim.tasks.front());
+      victim.tasks.pop_front();
+      --m_queued;
+      return true;
+    }
+  }
+  return false;
+};
+
+void ThreadPool::run(size_t self) {
+  t_pool  = this;
+  t_index = self;
+
+  Task task;
+  while (true) {
+    if (take(self, task)) {
+      task();
+      task = nullptr;
+
+      lock_guard<mutex> lock(m_mutex);
+      if (--m_pending == 0) m_idle.notify_all();
+      continue;
+    }
+
+    unique_lock<mutex> lock(m_mutex);
+    m_wake.wait(lock, [this] { return m_stop || m_queued > 0; });
+    if (m_stop && m_queued == 0) return;
+  }
+};
+};  // namespace flint
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace flint {
+
+/*
+ * A small work-stealing thread pool
+ *
+ * Every worker owns a deque of tasks. Tasks submitted from inside a worker go
+ * onto that worker's own deque and are popped LIFO (depth first, good for
+ * locality); an idle worker steals FIFO from the front of the others' deques,
+ * which for tree walks means it takes the oldest and usually biggest subtree.
+ */
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(size_t threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+  auto size() const -> size_t { return m_threads.size(); };
+
+  // Queues a task; from a worker it goes onto that worker's own deque
+  void submit(Task task);
+
+  // Blocks until every submitted task (and everything they submitted) is done
+  void wait();
+
+ private:
+  struct Queue {
+    std::mutex       mutex;
+    std::deque<Task> tasks;
+  };
+
+  void run(size_t self);
+  auto take(size_t self, Task& task) -> bool;
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<std::thread>            m_threads;
+
+  std::mutex              m_mutex;
+  std::condition_variable m_wake, m_idle;
+  std::atomic<size_t>     m_queued{0}, m_next{0};
+  size_t                  m_pending{0};  // queued + running, guarded by m_mutex
+  bool                    m_stop{false};
+};
+};  // namespace flint
@@ -1,45 +1,15 @@
 #include "Tokenizer.hpp"
 
-#include <numeric>
-#include <unordered_map>
+#include <cstdint>
 
-using namespace std;
+#include "ByteScan.hpp"
 
-// Tell map and unordered_map how to store StringFragments
-namespace std {
-template<>
-struct hash<flint::StringFragment> {
-  using argument_type = flint::StringFragment;
-  using value_type    = uint64_t;
-
-  inline auto operator()(const argument_type& fragment) const -> value_type {
-    return accumulate(fragment.begin(), fragment.end(), uint64_t(5381), [](uint64_t curr, char next) {
-      return ((curr << 5) + curr) + next;
-    });
-  };
-};
-};  // namespace std
+using namespace std;
 
 namespace flint {
 
 namespace {  // Anonymous Namespace for Tokenizing and munching functions
-using str_iter = string::const_iterator;
-
-static auto initializeKeywords() -> unordered_map<StringFragment, TokenType> {
-  static unordered_map<string, TokenType>  root;  // Will own all the strings; everybody else has StringFragments
-  unordered_map<StringFragment, TokenType> result;
-
-#define CPPLINT_ASSIGN(s, tk) root[string{s}] = tk;
-  CPPLINT_FORALL_KEYWORDS(CPPLINT_ASSIGN)
-#undef CPPLINT_ASSIGN
-
-  for (const auto& item: root) {
-    auto& key                                      = item.first;
-    result[StringFragment{key.begin(), key.end()}] = item.second;
-  }
-
-  return result;
-};
+using str_iter = const char*;
 
 // Oh good lord... Keep this for now,
 // then code review and find a cleaner method
@@ -52,10 +22,156 @@ static auto initializeKeywords() -> unordered_map<StringFragment, TokenType> {
     FBEXCEPTION(m);   \
   }
 
+/*
+ * Keyword lookup. CPPLINT_FORALL_KEYWORDS is turned into a perfect hash
+ * table at compile time, keyed on the first two bytes, the last byte and
+ * the length of a word. Most identifiers are rejected on their length and
+ * first byte before any hashing.
+ */
+struct Keyword {
+  const char* text;
+  size_t      size;
+  TokenType   type;
+};
+
+constexpr Keyword kKeywords[] = {
+#define CPPLINT_KEYWORD(s, tk) {s, sizeof(s) - 1, tk},
+    CPPLINT_FORALL_KEYWORDS(CPPLINT_KEYWORD)
+#undef CPPLINT_KEYWORD
+};
+constexpr size_t kNumKeywords  = sizeof(kKeywords) / sizeof(kKeywords[0]);
+constexpr size_t kKeywordSlots = 256;
+
+constexpr auto keywordHash(unsigned first, unsigned second, unsigned last, size_t size) -> size_t {
+  return (3 * first + 23 * second + 5 * last + 7 * size) % kKeywordSlots;
+};
+
+constexpr auto keywordHash(const Keyword& keyword) -> size_t {
+  return keywordHash(static_cast<unsigned char>(keyword.text[0]), static_cast<unsigned char>(keyword.text[1]),
+                     static_cast<unsigned char>(keyword.text[keyword.size - 1]), keyword.size);
+};
+
 /**
- * Map containing mappings of the kind "virtual" -> TK_VIRTUAL.
+ * @return
+ *        Returns one past the index of the keyword hashing to slot, or 0
  */
-static unordered_map<StringFragment, TokenType> keywords = initializeKeywords();
+constexpr auto keywordInSlot(size_t slot, size_t i = 0) -> unsigned char {
+  return i == kNumKeywords ? 0 : keywordHash(kKeywords[i]) == slot ? i + 1 : keywordInSlot(slot, i + 1);
+};
+
+template<size_t... Slots>
+struct Indices {};
+template<size_t N, size_t... Slots>
+struct MakeIndices : MakeIndices<N - 1, N - 1, Slots...> {};
+template<size_t... Slots>
+struct MakeIndices<0, Slots...> {
+  using type = Indices<Slots...>;
+};
+
+struct KeywordTable {
+  unsigned char slots[kKeywordSlots];
+};
+
+template<size_t... Slots>
+constexpr auto makeKeywordTable(Indices<Slots...>) -> KeywordTable {
+  return {{keywordInSlot(Slots)...}};
+};
+
+constexpr KeywordTable kKeywordTable = makeKeywordTable(MakeIndices<kKeywordSlots>::type{});
+
+constexpr auto usedSlots(size_t slot = 0) -> size_t {
+  return slot == kKeywordSlots ? 0 : (kKeywordTable.slots[slot] != 0) + usedSlots(slot + 1);
+};
+static_assert(usedSlots() == kNumKeywords, "Keywords collide in the hash table; pick new hash multipliers");
+
+// Bit n is set when some keyword is n bytes long, or starts with 'a' + n
+constexpr auto keywordLengths(size_t i = 0) -> uint32_t {
+  return i == kNumKeywords ? 0 : (uint32_t(1) << kKeywords[i].size) | keywordLengths(i + 1);
+};
+constexpr auto keywordInitials(size_t i = 0) -> uint32_t {
+  return i == kNumKeywords ? 0 : (uint32_t(1) << (kKeywords[i].text[0] - 'a')) | keywordInitials(i + 1);
+};
+constexpr auto wellFormed(size_t i = 0) -> bool {
+  return i == kNumKeywords || (kKeywords[i].size >= 2 && kKeywords[i].size < 32 && kKeywords[i].text[0] >= 'a' &&
+                               kKeywords[i].text[0] <= 'z' && wellFormed(i + 1));
+};
+static_assert(wellFormed(), "Keywords must be 2 to 31 bytes long and start with a lowercase letter");
+
+/**
+ * Tells keywords from other identifiers
+ *
+ * @param word
+ *        A non-empty identifier
+ * @return
+ *        Returns the keyword's token type, or TK_IDENTIFIER
+ */
+static auto keywordType(const StringFragment& word) -> TokenType {
+  const char*    text    = word.begin();
+  const size_t   size    = word.size();
+  const unsigned initial = static_cast<unsigned char>(text[0]) - 'a';
+  if (size >= 32 || !(keywordLengths() >> size & 1) || initial >= 26 || !(keywordInitials() >> initial & 1)) {
+    return TK_IDENTIFIER;
+  }
+
+  const size_t slot = keywordHash(static_cast<unsigned char>(text[0]), static_cast<unsigned char>(text[1]),
+                                  static_cast<unsigned char>(text[size - 1]), size);
+  const unsigned char index = kKeywordTable.slots[slot];
+  if (index == 0) return TK_IDENTIFIER;
+  const Keyword& keyword = kKeywords[index - 1];
+  return keyword.size == size && memcmp(keyword.text, text, size) == 0 ? keyword.type : TK_IDENTIFIER;
+};
+
+/*
+ * Character classes, so that scanning a byte is one table load and does
+ * not depend on the C locale
+ */
+enum CharClass : uint8_t {
+  CC_IDENT_START = 1 << 0,  // letters, '_', and '$' and '@' as extensions
+  CC_IDENT       = 1 << 1,  // the above and digits
+  CC_DIGIT       = 1 << 2,
+  CC_HEX         = 1 << 3,  // hex digits
+  CC_EXPONENT    = 1 << 4,  // EePp
+  CC_SUFFIX      = 1 << 5,  // FfLlUu
+  CC_CONTROL     = 1 << 6,  // ASCII control characters
+};
+
+constexpr auto isLetter(size_t c) -> bool {
+  return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+};
+
+constexpr auto isDigit(size_t c) -> bool {
+  return '0' <= c && c <= '9';
+};
+
+constexpr auto isOneOf(size_t c, const char* set) -> bool {
+  return *set && (c == static_cast<unsigned char>(*set) || isOneOf(c, set + 1));
+};
+
+constexpr auto classify(size_t c) -> uint8_t {
+  return (isLetter(c) || c == '_' || c == '$' || c == '@' ? CC_IDENT_START | CC_IDENT : 0) |
+         (isDigit(c) ? CC_DIGIT | CC_IDENT | CC_HEX : 0) | (isOneOf(c, "AaBbCcDdEeFf") ? CC_HEX : 0) |
+         (isOneOf(c, "EePp") ? CC_EXPONENT : 0) | (isOneOf(c, "FfLlUu") ? CC_SUFFIX : 0) |
+         (c < 0x20 || c == 0x7F ? CC_CONTROL : 0);
+};
+
+struct CharTable {
+  uint8_t classes[256];
+};
+
+template<size_t... Bytes>
+constexpr auto makeCharTable(Indices<Bytes...>) -> CharTable {
+  return {{classify(Bytes)...}};
+};
+
+constexpr CharTable kCharTable = makeCharTable(MakeIndices<256>::type{});
+
+/**
+ * @return
+ *        Returns whether c belongs to any of the given CharClasses
+ */
+inline auto is(char c, uint8_t classes) -> bool {
+  return (kCharTable.classes[static_cast<unsigned char>(c)] & classes) != 0;
+};
 
 /**
  * Eats howMany characters out of pc, advances pc appropriately, and
@@ -73,43 +189,33 @@ static auto munchChars(str_iter& pc, size_t howMany) -> StringFragment {
  * Assuming pc is positioned at the start of an identifier, munches it
  * from pc and returns it.
  */
-static auto munchIdentifier(str_iter& pc, str_iter inputEnd) -> StringFragment {
-  const size_t size = distance(pc, inputEnd);
-  for (size_t i = 0; i < size; ++i) {
-    assert(i < size);
-    const char c = pc[i];
-    // g++ allows '$' in identifiers. Also, some crazy inline
-    // assembler uses '@' in identifiers, see e.g.
-    // fbcode/external/cryptopp/rijndael.cpp, line 527
-    if (!isalnum(c) && c != '_' && c != '$' && c != '@') {
-      // done
-      ENFORCE(i > 0, "Invalid identifier: " + string(&*pc));
-      return munchChars(pc, i);
-    }
-  }
-  return munchChars(pc, size);
+static auto munchIdentifier(str_iter& pc) -> StringFragment {
+  // g++ allows '$' in identifiers. Also, some crazy inline
+  // assembler uses '@' in identifiers, see e.g.
+  // fbcode/external/cryptopp/rijndael.cpp, line 527
+  // The '\0' at the end of the input is not part of any identifier.
+  size_t i = 0;
+  while (is(pc[i], CC_IDENT)) ++i;
+  ENFORCE(i > 0, "Invalid identifier: " + string(&*pc));
+  return munchChars(pc, i);
 };
 
 /**
  * Assuming pc is positioned at the start of a C-style comment,
  * munches it from pc and returns it.
  */
-static auto munchComment(str_iter& pc, size_t& line) -> StringFragment {
+static auto munchComment(str_iter& pc, str_iter inputEnd, size_t& line) -> StringFragment {
   assert(pc[0] == '/' && pc[1] == '*');
-  for (size_t i = 2;; ++i) {
-    // assert(i < pc.size());
-    auto c = pc[i];
-    if (c == '\n') {
-      ++line;
-    } else if (c == '*') {
-      if (pc[i + 1] == '/') {
-        // end of comment
-        return munchChars(pc, i + 2);
-      }
-    } else if (!c) {
+  for (str_iter star = pc + 2;; ++star) {
+    star = scanForCountingLines(star, inputEnd, '*', '*', line);
+    if (!*star) {
       // end of input
       FBEXCEPTION("Unterminated comment: " + string(&*pc));
     }
+    if (star[1] == '/') {
+      // end of comment
+      return munchChars(pc, distance(pc, star) + 2);
+    }
   }
   assert(false);
 };
@@ -121,23 +227,23 @@ static auto munchComment(str_iter& pc, size_t& line) -> StringFragment {
 static auto munchSingleLineComment(str_iter& pc, str_iter inputEnd, size_t& line) -> StringFragment {
   assert(pc[0] == '/' && pc[1] == '/');
 
-  size_t size = distance(pc, inputEnd);
-  for (size_t i = 2; i < size; ++i) {
-    // assert(i < pc.size());
-    auto c = pc[i];
-    if (c == '\n') {
+  for (str_iter eol = pc + 2; eol != inputEnd; ++eol) {
+    // Stray '\0's inside the comment are skipped like any other character
+    eol = scanFor(eol, inputEnd, '\n', '\n');
+    if (*eol == '\n') {
       ++line;
-      if (i > 0 && pc[i - 1] == '\\') {
+      if (eol[-1] == '\\') {
         // multiline single-line comment (sic)
         // TODO: This should probably be a warning
         continue;
       }
       // end of comment
-      return munchChars(pc, i + 1);
+      return munchChars(pc, distance(pc, eol) + 1);
     }
+    if (eol == inputEnd) break;
   }
 
-  return munchChars(pc, size);
+  return munchChars(pc, distance(pc, inputEnd));
 };
 
 /**
@@ -153,19 +259,19 @@ static auto munchNumber(str_iter& pc) -> StringFragment {
     const auto c = pc[i];
     if (c == '.' && !sawDot && !sawExp && !sawSuffix) {
       sawDot = true;
-    } else if (isdigit(c)) {
+    } else if (is(c, CC_DIGIT)) {
       // Nothing to do
-    } else if (c == '\'' && !sawX && isdigit(pc[i + 1])) {
+    } else if (c == '\'' && !sawX && is(pc[i + 1], CC_DIGIT)) {
       // Nothing to do (numeric separator)
-    } else if (c == '\'' && sawX && pc[i + 1] && strchr("1234567890AaBbCcDdEeFf", pc[i + 1])) {
+    } else if (c == '\'' && sawX && is(pc[i + 1], CC_HEX)) {
       // Nothing to do (hex numeric separator)
-    } else if (sawX && !sawExp && c && strchr("AaBbCcDdEeFf", c)) {
+    } else if (sawX && !sawExp && is(c, CC_HEX)) {
       // Hex digit; nothing to do. The condition includes !sawExp
       // because the exponent is decimal even in a hex floating-point
       // number!
     } else if (c == '+' || c == '-') {
       // Sign may appear at the start or right after E or P
-      if (i > 0 && !strchr("EePp", pc[i - 1]))
+      if (i > 0 && !is(pc[i - 1], CC_EXPONENT))
         // Done, the sign is the next token
         return munchChars(pc, i);
     } else if (!sawX && !sawExp && !sawSuffix && (c == 'e' || c == 'E')) {
@@ -174,7 +280,7 @@ static auto munchNumber(str_iter& pc) -> StringFragment {
       sawExp = true;
     } else if ((c == 'x' || c == 'X') && i == 1 && pc[0] == '0') {
       sawX = true;
-    } else if (c && strchr("FfLlUu", c)) {
+    } else if (is(c, CC_SUFFIX)) {
       // It's a suffix. There could be several of them (including
       // repeats a la LL), so let's not return just yet
       sawSuffix = true;
@@ -215,21 +321,23 @@ static auto munchCharLiteral(str_iter& pc, size_t& line) -> StringFragment {
  * it from pc and returns it. A reference to line is passed in order
  * to track multiline strings correctly.
  */
-static auto munchString(str_iter& pc, size_t& line, bool isIncludeLiteral = false) -> StringFragment {
+static auto munchString(str_iter& pc, str_iter inputEnd, size_t& line, bool isIncludeLiteral = false)
+    -> StringFragment {
   const char stringEnd = isIncludeLiteral ? '>' : '"';
   assert(pc[0] == (isIncludeLiteral ? '<' : '"'));
 
-  for (size_t i = 1;; ++i) {
-    const auto c = pc[i];
+  for (str_iter i = pc + 1;; ++i) {
+    i = scanFor(i, inputEnd, stringEnd, '\\');
+    const auto c = *i;
     if (c == stringEnd)
       // That's about it
-      return munchChars(pc, i + 1);
-    if (c == '\\') {
+      return munchChars(pc, distance(pc, i) + 1);
+    if (c == '\\' && i + 1 != inputEnd) {
       ++i;
-      if (pc[i] == '\n') ++line;
+      if (*i == '\n') ++line;
       continue;
     }
-    ENFORCE(c, "Unterminated string constant: " + string(&*pc));
+    FBEXCEPTION("Unterminated string constant: " + string(&*pc));
   }
 };
 
@@ -238,7 +346,7 @@ static auto munchString(str_iter& pc, size_t& line, bool isIncludeLiteral = fals
  * it from pc and returns it. A reference to line is passed in order
  * to track multiline strings correctly.
  */
-static auto munchRawString(str_iter& pc, size_t& line) -> StringFragment {
+static auto munchRawString(str_iter& pc, str_iter inputEnd, size_t& line) -> StringFragment {
   assert(pc[0] == 'R');
   assert(pc[1] == '"');
   std::string    delim{')'};
@@ -251,6 +359,8 @@ static auto munchRawString(str_iter& pc, size_t& line) -> StringFragment {
   // We will ignore EVERYTHING that is not the delimeter (or a newline)
   size_t match_index = 0;  // Very lame character-by-character state machine
   for (size_t i = 0;; ++i) {
+    // Outside a partial match, nothing but a ')' can start the delimiter
+    if (match_index == 0) i = distance(pc, scanForCountingLines(pc + i, inputEnd, ')', ')', line));
     const auto c = pc[i];
     if (c == delim[match_index]) {
       if (++match_index == delim.length()) {            // Done!
@@ -275,34 +385,146 @@ static auto munchRawString(str_iter& pc, size_t& line) -> StringFragment {
  * sources, here is the place. No need for end-of-input checks as the
  * input always has a '\0' at the end.
  */
-static auto munchSpaces(str_iter& pc) -> StringFragment {
-  size_t i;
-  for (i = 0; pc[i] == ' ' || pc[i] == '\t'; ++i) {}
-
-  const auto result = StringFragment{pc, pc + i};
-  advance(pc, i);
+static auto munchSpaces(str_iter& pc, str_iter inputEnd) -> StringFragment {
+  const auto result = StringFragment{pc, skipBlanks(pc, inputEnd)};
+  pc                = result.end();
   return result;
 };
 
 };  // Anonymous Namespace
 
+void TokenList::indexTokens() {
+  enum Kind { CURL, PAREN, SQUARE, ANGLE, CONDITIONAL };
+
+  const auto count = static_cast<uint32_t>(size());
+  m_partners.resize(count);
+  m_arrayTemplates.clear();
+  m_symbols.clear();
+  m_seenSymbols = 0;
+  m_directives.clear();
+  for (auto& unclosed: m_unclosed) unclosed.clear();
+
+  const auto open = [this](Kind kind, uint32_t pos) { m_unclosed[kind].push_back(pos); };
+  const auto close = [this](Kind kind, uint32_t pos) {
+    // A stray closing bracket is left paired with itself
+    if (m_unclosed[kind].empty()) return;
+    const uint32_t opener = m_unclosed[kind].back();
+    m_unclosed[kind].pop_back();
+    m_partners[opener] = pos;
+    m_partners[pos]    = opener;
+  };
+
+  // Open conditionals are kept by the directive of their latest branch
+  auto&      conditionals = m_unclosed[CONDITIONAL];
+  const auto directive    = [this](uint32_t pos) {
+    m_directives.push_back({static_cast<TokenType>(m_types[pos]), pos, Directive::NONE, 0, 0});
+    return static_cast<uint32_t>(m_directives.size() - 1);
+  };
+  const auto branch = [&](uint32_t pos) {
+    // Ends the chain of the innermost open conditional, if any, with pos
+    const uint32_t index = directive(pos);
+    if (!conditionals.empty()) {
+      m_directives[conditionals.back()].next_ = index;
+      conditionals.pop_back();
+    }
+    return index;
+  };
+
+  for (uint32_t pos = 0; pos < count; ++pos) {
+    m_partners[pos] = pos;
+    ++m_counts[m_types[pos]];
+    switch (m_types[pos]) {
+      case TK_IDENTIFIER: {
+        const Symbol symbol = Symbols.find(m_base + m_offsets[pos], m_lengths[pos]);
+        if (symbol != SYM_NONE) {
+          m_symbols.push_back({pos, symbol});
+          m_seenSymbols |= symbolBit(symbol);
+        }
+      } break;
+      case TK_LCURL: open(CURL, pos); break;
+      case TK_RCURL: close(CURL, pos); break;
+      case TK_LPAREN: open(PAREN, pos); break;
+      case TK_RPAREN: close(PAREN, pos); break;
+      case TK_LSQUARE:
+        // Only the innermost open '<' sees it, as in skipTemplateSpec
+        if (!m_unclosed[ANGLE].empty()) m_arrayTemplates.push_back(m_unclosed[ANGLE].back());
+        open(SQUARE, pos);
+        break;
+      case TK_RSQUARE: close(SQUARE, pos); break;
+      case TK_LESS: open(ANGLE, pos); break;
+      case TK_GREATER: close(ANGLE, pos); break;
+      case TK_POUNDIF:
+      case TK_IFDEF:
+      case TK_IFNDEF: conditionals.push_back(directive(pos)); break;
+      case TK_POUNDELIF:
+      case TK_POUNDELSE:
+        // A stray #elif or #else starts no chain
+        if (conditionals.empty())
+          directive(pos);
+        else
+          conditionals.push_back(branch(pos));
+        break;
+      case TK_ENDIF: branch(pos); break;
+      case TK_DEFINE: directive(pos); break;
+      case TK_INCLUDE: {
+        Directive& include = m_directives[directive(pos)];
+        // The quotes or brackets around the path are left out
+        if (pos + 1 < count && m_types[pos + 1] == TK_STRING_LITERAL && m_lengths[pos + 1] >= 2) {
+          include.pathOffset_ = m_offsets[pos + 1] + 1;
+          include.pathLength_ = m_lengths[pos + 1] - 2;
+        }
+      } break;
+      default: break;
+    }
+  }
+
+  // Whatever is never closed runs up to the EOF token
+  for (const auto& unclosed: m_unclosed)
+    for (const uint32_t opener: unclosed) m_partners[opener] = count - 1;
+
+  sort(m_arrayTemplates.begin(), m_arrayTemplates.end());
+  m_arrayTemplates.erase(unique(m_arrayTemplates.begin(), m_arrayTemplates.end()), m_arrayTemplates.end());
+};
+
+auto TokenList::positions(TokenType type) const -> const vector<uint32_t>& {
+  vector<uint32_t>& found = m_positions[type];
+  if (m_indexed[type]) return found;
+
+  found.clear();
+  found.reserve(m_counts[type]);
+  const uint8_t* types = m_types.data();
+  const size_t   size  = m_types.size();
+  if (m_counts[type] * 16 < size) {
+    // Rare types are found faster by memchr than by looking at each token
+    for (const uint8_t* at = types; (at = static_cast<const uint8_t*>(memchr(at, type, types + size - at))); ++at)
+      found.push_back(static_cast<uint32_t>(at - types));
+  } else {
+    for (uint32_t pos = 0; pos < size; ++pos)
+      if (types[pos] == type) found.push_back(pos);
+  }
+
+  m_indexed[type] = true;
+  return found;
+};
+
 /**
  * Given the contents of a C++ file and a filename, tokenizes the
  * contents and places it in output.
  */
-auto tokenize(const string&   input,
-              const string&   file,
-              vector<Token>&  output,
-              vector<size_t>& structures,
-              ErrorFile&      errors) -> size_t {
-  output.clear();
-  structures.clear();
-
-  static const string         eof{"\0"};
-  static const string         empty{};
-  static const StringFragment nothing{begin(empty), end(empty)};
-
-  auto   pc   = input.begin();
+auto tokenize(const char*   inputBegin,
+              const char*   inputEnd,
+              const string& file,
+              TokenList&    output,
+              ErrorFile&    errors) -> size_t {
+  assert(*inputEnd == '\0');
+  // Tokens keep 32-bit offsets into the text
+  ENFORCE(static_cast<uint64_t>(distance(inputBegin, inputEnd)) < UINT32_MAX, "File too large to tokenize: " + file);
+  output.clear(inputBegin);
+
+  static const char* const    eof = "";
+  static const StringFragment nothing{eof, eof};
+
+  auto   pc   = inputBegin;
   size_t line = 1;
   if (startsWith(pc, "\xEF\xBB\xBF")) {  // UTF-8 BOM
     pc += 3;
@@ -315,25 +537,17 @@ auto tokenize(const string&   input,
   size_t         tokenLen{0};
   StringFragment whitespace = nothing;
 
-  while (pc != input.end()) {
+  while (pc != inputEnd) {
     const char c = pc[0];
     TokenType  t{TK_UNEXPECTED};
 
-    if (output.size() > 0) {
-      const auto tok = output.back().type_;
-      if ((tok == TK_CLASS || tok == TK_STRUCT || tok == TK_UNION) &&
-          (structures.empty() || structures.back() != output.size() - 1)) {
-        // If the last token added was the start of a structure, push it onto
-        // the list of structures
-        structures.push_back(output.size() - 1);
-      } else if (c == '<' && tok == TK_INCLUDE) {
-        // Special case for parsing #include <...>
-        // Previously the include path would not be captured as a string literal
-        const auto str = munchString(pc, line, true);
-        output.emplace_back(TK_STRING_LITERAL, move(str), line, whitespace);
-        whitespace = nothing;
-        continue;
-      }
+    if (c == '<' && output.size() > 0 && output.type(output.size() - 1) == TK_INCLUDE) {
+      // Special case for parsing #include <...>
+      // Previously the include path would not be captured as a string literal
+      const auto str = munchString(pc, inputEnd, line, true);
+      output.push_back(TK_STRING_LITERAL, move(str), line, whitespace);
+      whitespace = nothing;
+      continue;
     }
 
     switch (c) {
@@ -398,12 +612,12 @@ auto tokenize(const string&   input,
         // *** multi-line comments
       case '/':
         if (pc[1] == '*') {
-          const auto& comment = munchComment(pc, line);
+          const auto& comment = munchComment(pc, inputEnd, line);
           whitespace.append(comment.begin(), comment.end());
           break;
         }
         if (pc[1] == '/') {
-          const auto& single = munchSingleLineComment(pc, input.end(), line);
+          const auto& single = munchSingleLineComment(pc, inputEnd, line);
           whitespace.append(single.begin(), single.end());
           break;
         }
@@ -419,7 +633,7 @@ auto tokenize(const string&   input,
       case '\\':
         // Consume trailing whitespace after a valid backslash
         {
-          const auto& spaces = munchSpaces(pc);
+          const auto& spaces = munchSpaces(pc, inputEnd);
           whitespace.append(spaces.begin(), spaces.end());
         }
         // Take the case into account where a comment comes after a macro backslash
@@ -468,26 +682,27 @@ auto tokenize(const string&   input,
         // *** Whitespace
       case ' ':
       case '\t': {
-        const auto& spaces = munchSpaces(pc);
+        const auto& spaces = munchSpaces(pc, inputEnd);
         whitespace.append(spaces.begin(), spaces.end());
       } break;
         // *** Done parsing!
       case '\0':
         // assert(pc.size() == 0);
         // Push last token, the EOF
-        output.emplace_back(TK_EOF, StringFragment{eof.begin(), eof.end()}, line, whitespace);
+        output.push_back(TK_EOF, StringFragment{eof, eof}, line, whitespace);
+        output.indexTokens();
         return line;
         // *** Verboten characters (do allow '@' and '$' as extensions)
       case '`':
         errors.addError(ErrorObject(Lint::ERROR, line, "Invalid character found: Back-tick `", ""));
-        output.emplace_back(TK_UNEXPECTED, StringFragment{pc, pc + 1}, line, whitespace);
+        output.push_back(TK_UNEXPECTED, StringFragment{pc, pc + 1}, line, whitespace);
         ++pc;
         // cerr << ("Invalid character: " + string(1, c) + " in " + string(file + ":" +
         // to_string(line))) << endl;
         break;
         // *** Number, member selector, ellipsis, or .*
       case '.':
-        if (isdigit(pc[1])) { goto ITS_A_NUMBER; }
+        if (is(pc[1], CC_DIGIT)) { goto ITS_A_NUMBER; }
         if (pc[1] == '*') {
           t        = TK_DOT_STAR;
           tokenLen = 2;
@@ -513,14 +728,14 @@ auto tokenize(const string&   input,
       ITS_A_NUMBER: {
         auto symbol = munchNumber(pc);
         assert(symbol.size() > 0);
-        output.emplace_back(TK_NUMBER, move(symbol), line, whitespace);
+        output.push_back(TK_NUMBER, move(symbol), line, whitespace);
         whitespace = nothing;
       } break;
         // *** C++11 Raw String Literal
       case 'R':
         if (pc[1] == '"') {
-          auto str{munchRawString(pc, line)};
-          output.emplace_back(TK_RAW_STRING_LITERAL, move(str), line, whitespace);
+          auto str{munchRawString(pc, inputEnd, line)};
+          output.push_back(TK_RAW_STRING_LITERAL, move(str), line, whitespace);
           whitespace = nothing;
           break;
         }
@@ -528,27 +743,27 @@ auto tokenize(const string&   input,
         // *** Character literal
       case '\'': {
         auto charLit = munchCharLiteral(pc, line);
-        output.emplace_back(TK_CHAR_LITERAL, move(charLit), line, whitespace);
+        output.push_back(TK_CHAR_LITERAL, move(charLit), line, whitespace);
         whitespace = nothing;
       } break;
         // *** String literal
       case '"': {
-        auto str = munchString(pc, line);
-        output.emplace_back(TK_STRING_LITERAL, move(str), line, whitespace);
+        auto str = munchString(pc, inputEnd, line);
+        output.push_back(TK_STRING_LITERAL, move(str), line, whitespace);
         whitespace = nothing;
       } break;
       case '#': {
         // Skip leading ws
         auto pc1 = pc + 1;
-        tokenLen = 1 + munchSpaces(pc1).size();
+        tokenLen = 1 + munchSpaces(pc1, inputEnd).size();
         // The entire #line line is the token value
         if (startsWith(pc1, "line")) {
           t = TK_HASHLINE;
-          tokenLen += distance(pc1, find(pc1, input.end(), '\n'));
+          tokenLen += distance(pc1, find(pc1, inputEnd, '\n'));
         } else if (startsWith(pc1, "error")) {
           // The entire #error line is the token value
           t = TK_ERROR;
-          tokenLen += distance(pc1, find(pc1, input.end(), '\n'));
+          tokenLen += distance(pc1, find(pc1, inputEnd, '\n'));
           ENFORCE(tokenLen > 0, "Unterminated #error message");
         } else if (startsWith(pc1, "include")) {
           t = TK_INCLUDE;
@@ -585,10 +800,10 @@ auto tokenize(const string&   input,
           tokenLen += 2;                     // strlen("##");
         } else if (startsWith(pc1, "/*")) {  // Empty preprocessor directive but multi-line comment
           t = TK_POUND;
-          tokenLen += munchComment(pc1, line).size();
+          tokenLen += munchComment(pc1, inputEnd, line).size();
         } else if (startsWith(pc1, "//")) {  // Empty preprocessor directive but single line comment
           t = TK_POUND;
-          tokenLen += munchSingleLineComment(pc1, input.end(), line).size();
+          tokenLen += munchSingleLineComment(pc1, inputEnd, line).size();
         } else {
           // We can only assume this is inside a macro definition
           t = TK_POUND;
@@ -598,23 +813,16 @@ auto tokenize(const string&   input,
         goto INSERT_TOKEN;
         // *** Everything else
       default:
-        if (iscntrl(c)) {
+        if (is(c, CC_CONTROL)) {
           whitespace.append(pc, pc + 1);
           pc++;
-        } else if (isalpha(c) || c == '_' || c == '$' || c == '@') {
+        } else if (is(c, CC_IDENT_START)) {
           // it's a word
-          auto symbol = munchIdentifier(pc, input.cend());
-          auto iter   = keywords.find(symbol);
-          if (iter != keywords.end()) {
-            // keyword
-            output.emplace_back(iter->second, move(symbol), line, whitespace);
-            whitespace = nothing;
-          } else {
-            // Some identifier
-            assert(symbol.size() > 0);
-            output.emplace_back(TK_IDENTIFIER, move(symbol), line, whitespace);
-            whitespace = nothing;
-          }
+          auto symbol = munchIdentifier(pc);
+          assert(symbol.size() > 0);
+          // keyword or some identifier
+          output.push_back(keywordType(symbol), move(symbol), line, whitespace);
+          whitespace = nothing;
         } else {
           // what could this be? (BOM?)
           FBEXCEPTION("Unrecognized character in " + file + ":" + std::to_string(line));
@@ -622,14 +830,15 @@ auto tokenize(const string&   input,
         break;
         // *** All
       INSERT_TOKEN:
-        output.emplace_back(t, munchChars(pc, tokenLen), line, whitespace);
+        output.push_back(t, munchChars(pc, tokenLen), line, whitespace);
         t = TK_UNEXPECTED;
         whitespace = nothing;
         break;
     }
   }
 
-  output.emplace_back(TK_EOF, StringFragment{eof.begin(), eof.end()}, line, nothing);
+  output.push_back(TK_EOF, StringFragment{eof, eof}, line, nothing);
+  output.indexTokens();
 
   return line;
 };
@@ -1,11 +1,15 @@
 #pragma once
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
+#include <iterator>
 #include <string>
+#include <vector>
 
 #include "ErrorReport.hpp"
 #include "Polyfill.hpp"
+#include "Symbols.hpp"
 
 namespace flint {
 // clang-format off
@@ -221,8 +225,9 @@ enum TokenType {
 auto toString(const TokenType t) -> std::string;
 
 /**
- * Defines a substring of an existing string.  Lifetime is limited to the lifetime of the enclosing
- * string In other words, a StringFragment will take NO ownership of any memory.
+ * Defines a substring of an existing buffer (a std::string, a memory mapped file, ...).  Lifetime is
+ * limited to the lifetime of the enclosing buffer. In other words, a StringFragment will take NO
+ * ownership of any memory.
  *
  * Note: Remember to respect the range of most C++ iterators, which operate on [begin, end) (so end
  * expected to be out of range)
@@ -231,7 +236,7 @@ auto toString(const TokenType t) -> std::string;
  */
 struct StringFragment {
   using const_reference = const char&;
-  using citerator       = std::string::const_iterator;
+  using citerator       = const char*;
   using size_type       = size_t;
   using value_type      = char;
 
@@ -239,6 +244,7 @@ struct StringFragment {
   citerator end_;
 
   inline StringFragment(citerator begin, citerator end) NOEXCEPT: begin_(begin), end_(end) {}
+  inline explicit StringFragment(const std::string& str) NOEXCEPT: begin_(str.data()), end_(str.data() + str.size()) {}
   // This blows up on libc++:
   /* explicit StringFragment(const char* instr) : begin_(instr), end_(instr + strlen(instr)) {} */
 
@@ -265,58 +271,372 @@ inline auto to_string(const StringFragment& fragment) -> std::string {
 }
 
 inline auto operator==(const StringFragment& a, const StringFragment& b) -> bool {
-  return a.size() == b.size() and equal(a.begin(), a.end(), b.begin());
+  return a.size() == b.size() and std::equal(a.begin(), a.end(), b.begin());
 }
 
-inline auto contains(const StringFragment&     fragment,
-                     StringFragment::citerator stringBegin,
-                     StringFragment::citerator stringEnd) -> bool {
-  return search(fragment.begin(), fragment.end(), stringBegin, stringEnd) != fragment.end();
+inline auto contains(const StringFragment& fragment, const std::string& str) -> bool {
+  return std::search(fragment.begin(), fragment.end(), str.begin(), str.end()) != fragment.end();
 }
 
+class TokenList;
+
 /**
- * Defines one token together with file and line information. The
- * precedingWhitespace_ is set if there was leading whitespace.
+ * One token together with file and line information, as read from a
+ * TokenList. Tokens are small views made on demand, so take them by value
+ * or const reference and don't keep them past the list.
  */
 struct Token {
   TokenType      type_;
   StringFragment value_;
-  StringFragment precedingWhitespace_;
   size_t         line_;
 
-  Token(TokenType type, StringFragment value, size_t line, StringFragment whitespace)
-      : type_(type), value_(std::move(value)), precedingWhitespace_(std::move(whitespace)), line_(line){};
+  Token(TokenType type, StringFragment value, size_t line, const TokenList& list, size_t index)
+      : type_(type), value_(std::move(value)), line_(line), list_(&list), index_(index){};
+
+  /**
+   * @return
+   *        Returns the whitespace and comments right before the token, if any
+   */
+  inline auto precedingWhitespace() const -> StringFragment;
+
+  /**
+   * @return
+   *        Returns the id of the identifier, or SYM_NONE
+   */
+  inline auto symbol() const -> Symbol;
 
   auto toString() const -> std::string {
     std::string result{"Line:" + std::to_string(line_) + ':'};
     result.append(value_.begin(), value_.end());
     return result;
   };
+
+ private:
+  const TokenList* list_;
+  size_t           index_;
+};
+
+/**
+ * One preprocessor directive the checks look at: a conditional (#if,
+ * #ifdef, #ifndef, #elif, #else, #endif), an #include or a #define.
+ */
+struct Directive {
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  TokenType kind_;
+  uint32_t  token_;       // The position of the directive's token
+  uint32_t  next_;        // The directive of the next branch of a conditional, through to its #endif, or NONE
+  uint32_t  pathOffset_;  // Where the path of an #include "..." or <...> starts in the text
+  uint32_t  pathLength_;  // and its length without the quotes or brackets; 0 if there is none
 };
 
 /**
- * This is the quintessential function. Given a std::string containing C++
+ * The tokens of one file, stored as parallel arrays of their types,
+ * offsets into the file, lengths, lines and matching brackets. That's 17
+ * bytes a token, and a scan for a type only reads the 1-byte types.
+ * Preceding whitespace is kept on the side for just the tokens that have
+ * some.
+ */
+class TokenList {
+ public:
+  class const_iterator;
+
+  /**
+   * Empties the list, which will next hold tokens of the text at base
+   */
+  void clear(const char* base) {
+    m_base = base;
+    m_types.clear();
+    m_offsets.clear();
+    m_lengths.clear();
+    m_lines.clear();
+    m_whitespace.clear();
+    m_symbols.clear();
+    m_seenSymbols = 0;
+    m_partners.clear();
+    m_arrayTemplates.clear();
+    m_directives.clear();
+    std::fill(std::begin(m_counts), std::end(m_counts), 0);
+    std::fill(std::begin(m_indexed), std::end(m_indexed), false);
+  };
+
+  /**
+   * Makes room for count tokens, keeping what is already allocated
+   */
+  void reserve(size_t count) {
+    m_types.reserve(count);
+    m_offsets.reserve(count);
+    m_lengths.reserve(count);
+    m_lines.reserve(count);
+    m_whitespace.reserve(count);
+    m_partners.reserve(count);
+  };
+
+  void push_back(TokenType type, StringFragment value, size_t line, StringFragment whitespace) {
+    if (!whitespace.empty()) {
+      m_whitespace.push_back({static_cast<uint32_t>(m_types.size()), offsetOf(whitespace.begin()),
+                              static_cast<uint32_t>(whitespace.size())});
+    }
+    m_types.push_back(static_cast<uint8_t>(type));
+    // The EOF token's value is an empty string outside of the text
+    m_offsets.push_back(value.empty() ? 0 : offsetOf(value.begin()));
+    m_lengths.push_back(static_cast<uint32_t>(value.size()));
+    m_lines.push_back(static_cast<uint32_t>(line));
+  };
+
+  auto size() const -> size_t { return m_types.size(); };
+  auto empty() const -> bool { return m_types.empty(); };
+
+  auto operator[](size_t pos) const -> Token {
+    return Token(type(pos), value(pos), m_lines[pos], *this, pos);
+  };
+  auto back() const -> Token { return (*this)[size() - 1]; };
+
+  inline auto begin() const -> const_iterator;
+  inline auto end() const -> const_iterator;
+
+  auto type(size_t pos) const -> TokenType { return static_cast<TokenType>(m_types[pos]); };
+  auto value(size_t pos) const -> StringFragment {
+    return StringFragment{m_base + m_offsets[pos], m_base + m_offsets[pos] + m_lengths[pos]};
+  };
+  auto line(size_t pos) const -> size_t { return m_lines[pos]; };
+  auto symbol(size_t pos) const -> Symbol {
+    const auto found = std::lower_bound(m_symbols.begin(), m_symbols.end(), pos,
+                                        [](const SymbolAt& entry, size_t token) { return entry.token < token; });
+    return (found == m_symbols.end() || found->token != pos) ? SYM_NONE : found->symbol;
+  };
+
+  /**
+   * @return
+   *        Returns the bit standing for a symbol in seenSymbols(); all the
+   *        symbols from 63 on share the last one
+   */
+  static auto symbolBit(Symbol symbol) -> uint64_t { return uint64_t{1} << (symbol < 63 ? symbol : 63); };
+
+  /**
+   * @return
+   *        Returns the symbolBit()s of every symbol in the list
+   */
+  auto seenSymbols() const -> uint64_t { return m_seenSymbols; };
+
+  // An identifier with a symbol
+  struct SymbolAt {
+    uint32_t token;
+    Symbol   symbol;
+  };
+
+  /**
+   * @return
+   *        Returns the few identifiers which have a symbol, in order
+   */
+  auto symbolsAt() const -> const std::vector<SymbolAt>& { return m_symbols; };
+
+  /**
+   * @return
+   *        Returns the token types, one byte each
+   */
+  auto types() const -> const uint8_t* { return m_types.data(); };
+
+  auto precedingWhitespace(size_t pos) const -> StringFragment {
+    const auto found = std::lower_bound(m_whitespace.begin(), m_whitespace.end(), pos,
+                                        [](const Whitespace& entry, size_t token) { return entry.token < token; });
+    if (found == m_whitespace.end() || found->token != pos) return StringFragment{m_base, m_base};
+    return StringFragment{m_base + found->offset, m_base + found->offset + found->length};
+  };
+
+  /**
+   * Pairs up every (), [], {} and <> in one pass over the types, so that
+   * partner() can jump across them, counts the tokens of each type, looks
+   * up the Symbols of the identifiers and lists the directives. The tokenizer calls this once
+   * it has pushed the EOF token.
+   */
+  void indexTokens();
+
+  /**
+   * @return
+   *        Returns how many tokens of the given type the list holds
+   */
+  auto count(TokenType type) const -> size_t { return m_counts[type]; };
+
+  /**
+   * The positions of every token of a type, in order. Each list is only
+   * gathered the first time it is asked for, then shared by every caller
+   * until the list is cleared; a TokenList is never shared across threads.
+   *
+   * @return
+   *        Returns the sorted positions of the tokens of the given type
+   */
+  auto positions(TokenType type) const -> const std::vector<uint32_t>&;
+
+  /**
+   * @return
+   *        Returns the position of the bracket closing the one at pos, or of
+   *        the EOF token if it is never closed. A closing bracket gives back
+   *        its opening one, and any other token its own position.
+   */
+  auto partner(size_t pos) const -> size_t { return m_partners[pos]; };
+
+  /**
+   * @return
+   *        Returns whether a '[' sits between the '<' at pos and its
+   *        partner without being inside a nested <>
+   */
+  auto templateHasArray(size_t pos) const -> bool {
+    return std::binary_search(m_arrayTemplates.begin(), m_arrayTemplates.end(), pos);
+  };
+
+  /**
+   * The conditionals, #includes and #defines of the file, in order. A
+   * conditional left open has no #endif at the end of its next_ chain.
+   *
+   * @return
+   *        Returns the directives of the list
+   */
+  auto directives() const -> const std::vector<Directive>& { return m_directives; };
+
+  /**
+   * @return
+   *        Returns the path an #include directive names, pointing into the
+   *        text; empty for anything but a string literal or <...>
+   */
+  auto includedPath(const Directive& directive) const -> StringFragment {
+    const char* begin = m_base + directive.pathOffset_;
+    return StringFragment{begin, begin + directive.pathLength_};
+  };
+
+ private:
+  struct Whitespace {
+    uint32_t token;
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  auto offsetOf(const char* at) const -> uint32_t { return static_cast<uint32_t>(at - m_base); };
+
+  const char*             m_base = nullptr;
+  std::vector<uint8_t>    m_types;
+  std::vector<uint32_t>   m_offsets;
+  std::vector<uint32_t>   m_lengths;
+  std::vector<uint32_t>   m_lines;
+  std::vector<Whitespace> m_whitespace;
+  std::vector<SymbolAt>   m_symbols;
+  uint64_t                m_seenSymbols = 0;
+  std::vector<uint32_t>   m_partners;
+  std::vector<uint32_t>   m_arrayTemplates;  // Sorted positions of the '<'s for templateHasArray()
+  std::vector<Directive>  m_directives;
+  std::vector<uint32_t>   m_unclosed[5];     // Only used by indexTokens(), kept to reuse their memory
+  uint32_t                m_counts[NUM_TOKENS] = {};
+  // Filled on demand by positions(), hence mutable
+  mutable std::vector<uint32_t> m_positions[NUM_TOKENS];
+  mutable bool                  m_indexed[NUM_TOKENS] = {};
+};
+static_assert(NUM_TOKENS <= 256, "TokenList stores token types in a byte");
+
+inline auto Token::precedingWhitespace() const -> StringFragment {
+  return list_->precedingWhitespace(index_);
+};
+
+inline auto Token::symbol() const -> Symbol {
+  return list_->symbol(index_);
+};
+
+/**
+ * Walks a TokenList, yielding Tokens by value
+ */
+class TokenList::const_iterator {
+ public:
+  // Lets it->value_ work even though there is no Token to point at
+  struct Arrow {
+    Token token;
+    auto  operator->() const -> const Token* { return &token; };
+  };
+
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type        = Token;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = Arrow;
+  using reference         = Token;
+
+  const_iterator() = default;
+  const_iterator(const TokenList* list, size_t pos): m_list(list), m_pos(pos){};
+
+  auto operator*() const -> Token { return (*m_list)[m_pos]; };
+  auto operator->() const -> Arrow { return Arrow{**this}; };
+  auto operator[](difference_type n) const -> Token { return (*m_list)[m_pos + n]; };
+
+  auto operator++() -> const_iterator& {
+    ++m_pos;
+    return *this;
+  };
+  auto operator--() -> const_iterator& {
+    --m_pos;
+    return *this;
+  };
+  auto operator++(int) -> const_iterator { return const_iterator(m_list, m_pos++); };
+  auto operator--(int) -> const_iterator { return const_iterator(m_list, m_pos--); };
+  auto operator+=(difference_type n) -> const_iterator& {
+    m_pos += n;
+    return *this;
+  };
+  auto operator-=(difference_type n) -> const_iterator& {
+    m_pos -= n;
+    return *this;
+  };
+  auto operator+(difference_type n) const -> const_iterator { return const_iterator(m_list, m_pos + n); };
+  auto operator-(difference_type n) const -> const_iterator { return const_iterator(m_list, m_pos - n); };
+  auto operator-(const const_iterator& other) const -> difference_type {
+    return static_cast<difference_type>(m_pos) - static_cast<difference_type>(other.m_pos);
+  };
+
+  auto operator==(const const_iterator& other) const -> bool { return m_pos == other.m_pos; };
+  auto operator!=(const const_iterator& other) const -> bool { return m_pos != other.m_pos; };
+  auto operator<(const const_iterator& other) const -> bool { return m_pos < other.m_pos; };
+  auto operator>(const const_iterator& other) const -> bool { return m_pos > other.m_pos; };
+  auto operator<=(const const_iterator& other) const -> bool { return m_pos <= other.m_pos; };
+  auto operator>=(const const_iterator& other) const -> bool { return m_pos >= other.m_pos; };
+
+ private:
+  const TokenList* m_list = nullptr;
+  size_t           m_pos  = 0;
+};
+
+inline auto operator+(std::ptrdiff_t n, const TokenList::const_iterator& it) -> TokenList::const_iterator {
+  return it + n;
+}
+
+inline auto TokenList::begin() const -> const_iterator {
+  return const_iterator(this, 0);
+};
+inline auto TokenList::end() const -> const_iterator {
+  return const_iterator(this, size());
+};
+
+/**
+ * This is the quintessential function. Given a buffer containing C++
  * code and a filename, fills output with the tokens in the
- * file.
+ * file. The buffer must be followed by a '\0' (*inputEnd == '\0').
  */
-auto tokenize(const std::string&   input,
-              const std::string&   initialFilename,
-              std::vector<Token>&  output,
-              std::vector<size_t>& structures,
-              ErrorFile&           errors) -> size_t;
+auto tokenize(const char*        inputBegin,
+              const char*        inputEnd,
+              const std::string& initialFilename,
+              TokenList&         output,
+              ErrorFile&         errors) -> size_t;
+
+/**
+ * Tokenizes the contents of a std::string, see above
+ */
+inline auto tokenize(const std::string& input,
+                     const std::string& initialFilename,
+                     TokenList&         output,
+                     ErrorFile&         errors) -> size_t {
+  return tokenize(input.data(), input.data() + input.size(), initialFilename, output, errors);
+}
 
 /**
  * Prevent the use of temporaries for input and filename
  * because the resulting tokens contain StringPiece objects pointing
  * into them.
  */
-auto tokenize(std::string&&, const std::string&, std::vector<Token>&, std::vector<size_t>&, ErrorFile&)
-    -> size_t = delete;
-auto tokenize(const std::string&, std::string&&, std::vector<Token>&, std::vector<size_t>&, ErrorFile&)
-    -> size_t = delete;
+auto tokenize(std::string&&, const std::string&, TokenList&, ErrorFile&) -> size_t = delete;
+auto tokenize(const std::string&, std::string&&, TokenList&, ErrorFile&) -> size_t = delete;
 };  // namespace flint
-
-namespace std {
-template<>
-struct hash<flint::StringFragment>;
-};
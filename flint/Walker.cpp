@@ -0,0 +1,160 @@
+#include "Walker.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "FileCategories.hpp"
+#include "Options.hpp"
+#include "Polyfill.hpp"
+#include "Stats.hpp"
+
+using namespace std;
+
+namespace flint {
+
+Walker::Walker(const vector<string>& paths, size_t threads, const vector<string>& files)
+    : m_root("", 0, true), m_cwd(fsCurrentDir()), m_pool(threads) {
+  // The command line entries are children of an invisible, already scanned root
+  for (const auto& path: paths) {
+    const auto fsType = fsObjectExists(path);
+    if (fsType == FSType::NO_ACCESS) {
+      fprintf(stderr, "Explicitly requested file/path '%s' does not exist.\n\n", path.c_str());
+      continue;
+    }
+
+    const bool isDir = fsType == FSType::IS_DIR;
+    if ((isDir || getFileCategory(path) != FileCategory::UNKNOWN) && m_named.insert(pathKey(path)).second) {
+      m_root.children.emplace_back(new Node(path, 0, isDir));
+      m_namedFiles |= !isDir;
+    }
+  }
+
+  // Listed files were already filtered, and a missing one is reported when it is read
+  for (const auto& path: files) {
+    if (m_named.insert(pathKey(path)).second) {
+      m_root.children.emplace_back(new Node(path, 0, false));
+      m_namedFiles = true;
+    }
+  }
+  m_root.scanned = true;
+  m_stack.push_back({&m_root, 0});
+
+  if (m_pool.size() == 0) return;
+  for (auto& child: m_root.children) {
+    Node* dir = child.get();
+    if (dir->isDir) m_pool.submit([this, dir] { scan(*dir); });
+  }
+};
+
+Walker::~Walker() {
+  // Scans still in flight write into our nodes
+  m_pool.wait();
+};
+
+/**
+ * Lists a directory, keeping the subdirectories worth descending into and
+ * the files worth linting, then queues a scan of each kept subdirectory
+ *
+ * @param dir
+ *        The directory node to fill in
+ */
+void Walker::scan(Node& dir) {
+  vector<unique_ptr<Node>> children;
+
+  vector<DirEntry> entries;
+  bool             noLint;
+  if (fsScanDir(dir.path, entries, noLint) && !noLint) {
+    // A .flintignore here adds to the rules inherited from above
+    shared_ptr<const IgnoreRules> rules = dir.ignore;
+    const bool hasIgnoreFile = any_of(entries.begin(), entries.end(), [](const DirEntry& entry) {
+      return entry.type == FSType::IS_FILE && entry.name == ".flintignore";
+    });
+    if (hasIgnoreFile) {
+      shared_ptr<IgnoreRules> own = make_shared<IgnoreRules>(rules, dir.path);
+      if (own->load(dir.path + FS_SEP + ".flintignore")) rules = move(own);
+    }
+
+    for (auto& entry: entries) {
+      if (entry.type == FSType::IS_DIR) {
+        // Only the top level is listed without --recursive
+        if (!Options.RECURSIVE) continue;
+        if (rules && rules->ignored(dir.path, entry.name, true)) {
+          ++Stats.ignoredDirs;
+          continue;
+        }
+        children.emplace_back(new Node(dir.path + FS_SEP + entry.name, dir.depth + 1, true, rules));
+      } else if (entry.type == FSType::IS_FILE && getFileCategory(entry.name) != FileCategory::UNKNOWN) {
+        if (rules && rules->ignored(dir.path, entry.name, false)) {
+          ++Stats.ignoredFiles;
+          // Sizing a file costs a stat, so only do it when asked to
+          if (Options.PRINT_IGNORED_STATS) Stats.ignoredBytes += fsFileSize(dir.path + FS_SEP + entry.name);
+          continue;
+        }
+        // Only files worth linting are given a full path
+        children.emplace_back(new Node(dir.path + FS_SEP + entry.name, dir.depth + 1, false));
+      }
+    }
+  }
+  ++Stats.dirsScanned;
+
+  if (m_pool.size() > 0) {
+    for (auto& child: children) {
+      Node* sub = child.get();
+      if (sub->isDir) m_pool.submit([this, sub] { scan(*sub); });
+    }
+  }
+
+  {
+    lock_guard<mutex> lock(m_mutex);
+    dir.children = move(children);
+    dir.scanned  = true;
+  }
+  m_scanned.notify_all();
+};
+
+auto Walker::next(string& path) -> bool {
+  unique_lock<mutex> lock(m_mutex);
+  while (!m_stack.empty()) {
+    Node& node = *m_stack.back().node;
+
+    if (!node.scanned) {
+      if (m_pool.size() == 0) {
+        // Serial mode: list directories lazily, exactly when they are reached
+        lock.unlock();
+        scan(node);
+        lock.lock();
+      } else {
+        m_scanned.wait(lock, [&node] { return node.scanned; });
+      }
+    }
+
+    Cursor& top = m_stack.back();
+    if (top.child == node.children.size()) {
+      // Everything below here has been handed out; free it
+      node.children.clear();
+      m_stack.pop_back();
+      continue;
+    }
+
+    Node& child = *node.children[top.child++];
+    if (child.isDir) {
+      m_stack.push_back({&child, 0});
+      continue;
+    }
+    // Skip files found in a directory that were also named explicitly
+    if (m_namedFiles && child.depth > 0 && m_named.count(pathKey(child.path))) continue;
+
+    path = move(child.path);
+    return true;
+  }
+  return false;
+};
+
+/**
+ * Spells a path the same way however it was reached, so
+ * that it can be recognized when it is reached again
+ */
+auto Walker::pathKey(const string& path) const -> string {
+  return normalizePath(fsIsAbsolute(path) ? path : m_cwd + FS_SEP + path);
+};
+};  // namespace flint
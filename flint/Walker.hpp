@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "IgnoreRules.hpp"
+#include "ThreadPool.hpp"
+
+namespace flint {
+
+/*
+ * Finds the files to lint below a list of paths
+ *
+ * Directories are listed concurrently on a work-stealing pool: as soon as a
+ * directory has been read, each of its subdirectories is queued for its own
+ * scan. Meanwhile next() hands out lintable files in exactly the order a
+ * serial, sorted, depth-first walk would visit them, only blocking when the
+ * directory it needs next has not been read yet. Consumers can therefore
+ * start linting long before the whole tree has been listed.
+ *
+ * Entries matched by a .flintignore are dropped as their directory is
+ * listed, so ignored subtrees are never opened.
+ *
+ * Files that come from a list rather than a directory are handed out
+ * as they are, without touching the file system. A file reached by more
+ * than one route is only handed out the first time.
+ */
+class Walker {
+ public:
+  /**
+   * @param paths
+   *        The paths given on the command line; each is checked immediately
+   * @param threads
+   *        Number of scanning threads; with none, next() scans inline
+   * @param files
+   *        Lintable files from lists, handed out after those in paths
+   */
+  Walker(const std::vector<std::string>& paths, size_t threads, const std::vector<std::string>& files = {});
+  ~Walker();
+
+  Walker(const Walker&) = delete;
+  auto operator=(const Walker&) -> Walker& = delete;
+
+  /**
+   * Fetches the next lintable file in walk order. Not reentrant; callers
+   * sharing a Walker must serialize their calls.
+   *
+   * @param path
+   *        Filled with the path of the file
+   * @return
+   *        Returns false once every file has been handed out
+   */
+  auto next(std::string& path) -> bool;
+
+ private:
+  struct Node {
+    std::string                        path;
+    size_t                             depth;
+    bool                               isDir;
+    bool                               scanned{false};  // guarded by m_mutex
+    std::vector<std::unique_ptr<Node>> children;
+    std::shared_ptr<const IgnoreRules> ignore;  // the .flintignore rules in effect inside a directory
+
+    Node(std::string p, size_t d, bool dir, std::shared_ptr<const IgnoreRules> rules = nullptr)
+        : path(std::move(p)), depth(d), isDir(dir), ignore(std::move(rules)){};
+  };
+
+  void scan(Node& dir);
+  auto pathKey(const std::string& path) const -> std::string;
+
+  struct Cursor {
+    Node*  node;
+    size_t child;
+  };
+
+  Node                            m_root;
+  std::string                     m_cwd;
+  std::unordered_set<std::string> m_named;  // pathKey() of each path given up front
+  bool                            m_namedFiles{false};
+  std::vector<Cursor>             m_stack;
+  std::mutex                      m_mutex;
+  std::condition_variable         m_scanned;
+  ThreadPool                      m_pool;
+};
+};  // namespace flint
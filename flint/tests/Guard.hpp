@@ -0,0 +1,19 @@
+#ifndef GUARD_HPP
+#define GUARD_HPP
+
+// Branches inside the guard belong to their own #if
+#if defined(A)
+int a;
+#elif defined(B)
+int b;
+#else
+#ifdef C
+int c;
+#endif
+#endif
+
+#else
+
+#endif
+
+int outsideTheGuard;
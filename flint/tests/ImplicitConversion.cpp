@@ -10,6 +10,10 @@ namespace GRR {
 			explicit operator char();
 
 			/* implicit */ operator int();
+
+			explicit constexpr operator double();
+			operator bool() const = delete;
+			operator float();
 		};
 
 		operator bool();
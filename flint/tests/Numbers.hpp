@@ -12,6 +12,13 @@ namespace NumbersCpp14 {
   static constexpr int c2 = 0xFFFF'0FFF;
   static constexpr int d2 = 0xFFFF'0FFFul;
   static constexpr int e2 = 0xFFFF'0FFFull;
+  // ...and so should exponents, hex floats and suffixes, whose signs belong to the number
+  static constexpr double f = 1.5e-3+2;
+  static constexpr double f2 = 0x1.8p+4-0xA.Bp-1;
+  static constexpr float f3 = 6.02E23F;
+  static constexpr long double f4 = .5e+10L;
+  static constexpr unsigned long long g = 1'2'3ULL+0x1'aBull;
+  static constexpr int $h = 0xaBcDeF-1;
 }
 
 #endif
@@ -0,0 +1,29 @@
+#pragma once
+
+class Forward;
+
+class Wrapper {
+ public:
+  operator int() const;
+};
+
+class EXPORT_API Exported final {
+ public:
+  Exported(int value);
+};
+
+template <class T>
+T make(int value) {
+  return T(value);
+}
+
+namespace outer VISIBILITY(default) {
+static int counter;
+
+struct Outer {
+  struct Inner {
+    virtual void foo();
+  };
+  ~Outer();
+};
+}  // namespace outer